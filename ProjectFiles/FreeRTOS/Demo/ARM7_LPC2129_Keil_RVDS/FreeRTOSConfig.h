@@ -29,6 +29,7 @@
 #define FREERTOS_CONFIG_H
 
 #include <lpc21xx.h>
+#include "GPIO.h"
 
 /*-----------------------------------------------------------
  * Application specific definitions.
@@ -42,6 +43,7 @@
  * See http://www.freertos.org/a00110.html
  *----------------------------------------------------------*/
 #define configUSE_EDF_SCHEDULER         1
+#define configSCHEDULING_POLICY         schedPOLICY_EDF		/* schedPOLICY_EDF, schedPOLICY_RM, schedPOLICY_DM, schedPOLICY_LLF or schedPOLICY_EDZL */
 #define configUSE_APPLICATION_TASK_TAG  1
 #define PERFORMANCE_EVALUATION					1
 
@@ -56,24 +58,17 @@
 #define PROBE_IDLE				PIN7
 
 
-#if (PERFORMANCE_EVALUATION == 1)	
-	#define traceTASK_SWITCHED_IN()																																		\
-		do{																																															\
-				GPIO_write(PROBE_PORT, TagToPinMap((uint8_t)(pxCurrentTCB->pxTaskTag)), PIN_IS_HIGH);				\
-				performanceEvaluation.taskTime[(uint8_t)(pxCurrentTCB->pxTaskTag)].inTime = T1TC;						\
-		}while(0)
-
-	#define traceTASK_SWITCHED_OUT()																																	\
-		do{																																															\
-				GPIO_write(PROBE_PORT, TagToPinMap((uint8_t)(pxCurrentTCB->pxTaskTag)), PIN_IS_LOW);				\
-				performanceEvaluation.taskTime[(uint8_t)(pxCurrentTCB->pxTaskTag)].totalTime += 						\
-								T1TC - performanceEvaluation.taskTime[(uint8_t)(pxCurrentTCB->pxTaskTag)].inTime;  	\
-		}while(0)
-	
-#else
-		#define traceTASK_SWITCHED_IN()	  	GPIO_write(PROBE_PORT, TagToPinMap((uint8_t)(pxCurrentTCB->pxTaskTag)), PIN_IS_HIGH)
-		#define traceTASK_SWITCHED_OUT()    GPIO_write(PROBE_PORT, TagToPinMap((uint8_t)(pxCurrentTCB->pxTaskTag)), PIN_IS_LOW)
-#endif
+#define traceTASK_SWITCHED_IN()																																		\
+	do{																																															\
+			GPIO_PROBE_HIGH(GPIO_TASK_PROBE(pxCurrentTCB->pxTaskTag));																\
+			traceRECORDER_TASK_SWITCHED_IN();																											\
+	}while(0)
+
+#define traceTASK_SWITCHED_OUT()																																	\
+	do{																																															\
+			GPIO_PROBE_LOW(GPIO_TASK_PROBE(pxCurrentTCB->pxTaskTag));																\
+			traceRECORDER_TASK_SWITCHED_OUT();																										\
+	}while(0)
 
 		
 #define vApplicationIdleTAG_SET()		vTaskSetApplicationTaskTag(NULL, (void *)0);
@@ -81,6 +76,7 @@
 
 
 #define configSUPPORT_DYNAMIC_ALLOCATION 		1
+#define configSUPPORT_STATIC_ALLOCATION 		1
 
 #define configUSE_PREEMPTION		1
 #define configUSE_IDLE_HOOK			1
@@ -89,14 +85,62 @@
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 2 * 1024 )
+#define configTLSF_FL_INDEX_MAX		12								/* heap_tlsf.c: the heap must be smaller than 2 ^ 12 bytes */
+#define configARENA_LOCK_AFTER_SCHEDULER_START	1					/* heap_arena.c: no allocation once the scheduler is running */
+#define configUSE_HEAP_CATEGORIES	1
 #define configMAX_TASK_NAME_LEN		( 8 )
-#define configUSE_TRACE_FACILITY	0
+#define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 
 
 #define configQUEUE_REGISTRY_SIZE 	0
+#define configUSE_DEADLINE_QUEUES	1								/* The consumer queue hands out the most urgent message first */
+#define configUSE_DEADLINE_INHERITANCE	1							/* The consumer runs on the deadline of the most urgent message it serves */
+#define configUSE_LOGICAL_EXECUTION_TIME	1						/* The consumer's UART output is committed at its deadline */
+
+/* Kernel trace recorder, dumped over the UART when it stops */
+#define configUSE_TRACE_RECORDER				1
+#define configTRACE_RECORDER_BUFFER_LENGTH		256
+#define configTRACE_RECORDER_POST_TRIGGER		64
+#define configTRACE_RECORDER_TIMESTAMP()		T1TC						/* Timer 1, ~16.7us per count */
+#define configTRACE_RECORDER_MASK_INTERRUPTS()	( ( UBaseType_t ) __disable_irq() )	/* IRQs don't nest, so the port's mask from ISR does nothing */
+#define configTRACE_RECORDER_UNMASK_INTERRUPTS(uxStatus)	do{ if((uxStatus) == 0) __enable_irq(); }while(0)
+
+/* Run time stats, kept by the kernel over windows of a fixed number of ticks */
+#define configGENERATE_RUN_TIME_STATS			PERFORMANCE_EVALUATION
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()						/* Timer 1 is started by prvSetupHardware() */
+#define portGET_RUN_TIME_COUNTER_VALUE()		T1TC
+#define configRUN_TIME_WINDOWS					3
+#define configRUN_TIME_WINDOW_TICKS				{ 100, 1000, 10000 }		/* Hyperperiod of the task table, 1s and 10s */
+#define RUN_TIME_WINDOW_CPU_LOAD				1						/* Window the idle hook reports the CPU load over */
+
+/* Job timing histograms per task, dumped over the UART on request */
+#define configUSE_JOB_STATS						1
+#define configJOB_STATS_BUCKETS					16						/* Up to 2^15 timer 1 counts, ~0.5s */
+#define configJOB_STATS_TIMESTAMP()				T1TC
+#define configJOB_STATS_TICKS_TO_TIMESTAMP(xTicks)	( ( uint32_t ) ( xTicks ) * 5994UL / 100UL )	/* 59.94 timer 1 counts per tick */
+
+/* Interrupt and scheduler time kept apart from the task run times, sent with the job statistics */
+#define configUSE_CPU_ACCOUNTING				PERFORMANCE_EVALUATION
+#define configACCOUNTING_ISRS					2
+#define configTICK_ISR_NUMBER					0
+#define ACCOUNTING_ISR_UART						1
+
+/* Longest time interrupts stay masked and the scheduler suspended, per call site, sent with the job statistics */
+#define configUSE_CRITICAL_PROFILER				PERFORMANCE_EVALUATION
+#define configCRITICAL_PROFILER_TIMESTAMP()		T0TC						/* Tick timer, one count per CPU clock */
+#define configCRITICAL_PROFILER_TIMESTAMP_PERIOD	( ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) + 1UL )	/* Reset on the tick match */
+#define configCRITICAL_PROFILER_SITES			24
+#define configCRITICAL_PROFILER_BUCKETS			17						/* Up to a whole tick */
+#define CRITICAL_FILE_SERIAL					( criticalFILE_APPLICATION + 0 )
+#define CRITICAL_FILE_LATENCY					( criticalFILE_APPLICATION + 1 )
+
+/* Stack high water marks sampled from the idle hook, with a logged recommendation per task */
+#define configUSE_STACK_WATERMARKS				1
+#define configSTACK_WATERMARK_MARGIN_PERCENT	25
+#define configSTACK_WATERMARK_MARGIN_WORDS		18						/* Context an interrupt saves on the task stack */
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
@@ -105,13 +149,16 @@
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
-#define INCLUDE_vTaskPrioritySet		1
-#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskPrioritySet		0
+#define INCLUDE_uxTaskPriorityGet		0
 #define INCLUDE_vTaskDelete				1
 #define INCLUDE_vTaskCleanUpResources	0
 #define INCLUDE_vTaskSuspend			1
 #define INCLUDE_vTaskDelayUntil			1
 #define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetSchedulerState	1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#define INCLUDE_xTaskGetIdleTaskHandle	1
 
 
 
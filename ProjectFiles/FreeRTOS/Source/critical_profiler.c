@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+PRIVILEGED_DATA static CriticalSite_t xSites[ configCRITICAL_PROFILER_SITES ];
+PRIVILEGED_DATA static UBaseType_t uxSitesUsed = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static UBaseType_t uxDropped = ( UBaseType_t ) 0U;
+
+/* The outermost critical section of the running task, only used with
+ * interrupts masked. */
+PRIVILEGED_DATA static UBaseType_t uxCriticalDepth = ( UBaseType_t ) 0U;
+PRIVILEGED_DATA static uint32_t ulCriticalSite = 0UL;
+PRIVILEGED_DATA static uint32_t ulCriticalStart = 0UL;
+
+/* The outermost scheduler suspension.  No other task can run while it is
+ * set, and interrupts do not use it. */
+PRIVILEGED_DATA static uint32_t ulSuspendSite = 0UL;
+PRIVILEGED_DATA static uint32_t ulSuspendStart = 0UL;
+
+/*
+ * Charges the time from ulStart to now to ulSite, adding the call site to the
+ * table the first time it is seen.  Must be called with interrupts masked.
+ */
+static void prvRecord( uint32_t ulSite,
+                       uint32_t ulStart ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvRecord( uint32_t ulSite,
+                       uint32_t ulStart )
+{
+    uint32_t ulDuration = configCRITICAL_PROFILER_TIMESTAMP() - ulStart;
+    CriticalSite_t * pxSite = NULL;
+    UBaseType_t uxIndex, uxBucket = ( UBaseType_t ) 0U;
+
+    /* The unsigned difference is right across a wrap of a free running
+     * counter, one that wraps earlier needs its period added back. */
+    if( ( configCRITICAL_PROFILER_TIMESTAMP_PERIOD != 0UL ) && ( ulDuration >= ( uint32_t ) configCRITICAL_PROFILER_TIMESTAMP_PERIOD ) )
+    {
+        ulDuration += ( uint32_t ) configCRITICAL_PROFILER_TIMESTAMP_PERIOD;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxSitesUsed; uxIndex++ )
+    {
+        if( xSites[ uxIndex ].ulSite == ulSite )
+        {
+            pxSite = &( xSites[ uxIndex ] );
+            break;
+        }
+    }
+
+    if( pxSite == NULL )
+    {
+        if( uxSitesUsed < ( UBaseType_t ) configCRITICAL_PROFILER_SITES )
+        {
+            pxSite = &( xSites[ uxSitesUsed ] );
+            uxSitesUsed++;
+            ( void ) memset( ( void * ) pxSite, 0x00, sizeof( CriticalSite_t ) );
+            pxSite->ulSite = ulSite;
+        }
+        else
+        {
+            uxDropped++;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxSite != NULL )
+    {
+        if( ulDuration > pxSite->ulMaxDuration )
+        {
+            pxSite->ulMaxDuration = ulDuration;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxSite->ulCount++;
+
+        /* No count leading zeros instruction is assumed. */
+        while( ( ulDuration != 0UL ) && ( uxBucket < ( UBaseType_t ) ( configCRITICAL_PROFILER_BUCKETS - 1 ) ) )
+        {
+            ulDuration >>= 1;
+            uxBucket++;
+        }
+
+        if( pxSite->usHistogram[ uxBucket ] < ( uint16_t ) 0xFFFFU )
+        {
+            ( pxSite->usHistogram[ uxBucket ] )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerEnter( uint32_t ulSite )
+{
+    if( uxCriticalDepth == ( UBaseType_t ) 0U )
+    {
+        ulCriticalSite = ulSite;
+        ulCriticalStart = configCRITICAL_PROFILER_TIMESTAMP();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    uxCriticalDepth++;
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerExit( void )
+{
+    if( uxCriticalDepth > ( UBaseType_t ) 0U )
+    {
+        uxCriticalDepth--;
+
+        if( uxCriticalDepth == ( UBaseType_t ) 0U )
+        {
+            prvRecord( ulCriticalSite, ulCriticalStart );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxCriticalProfilerSwitchOut( uint32_t * pulSite )
+{
+    UBaseType_t uxDepth = uxCriticalDepth;
+
+    /* Called from vTaskSwitchContext(), so interrupts are masked whatever the
+     * depth is. */
+    if( uxDepth > ( UBaseType_t ) 0U )
+    {
+        prvRecord( ulCriticalSite, ulCriticalStart );
+        *pulSite = ulCriticalSite;
+        uxCriticalDepth = ( UBaseType_t ) 0U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxDepth;
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerSwitchIn( UBaseType_t uxDepth,
+                                uint32_t ulSite )
+{
+    /* A task switched in inside a critical section resumes with interrupts
+     * masked again. */
+    uxCriticalDepth = uxDepth;
+    ulCriticalSite = ulSite;
+    ulCriticalStart = configCRITICAL_PROFILER_TIMESTAMP();
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerSuspend( uint32_t ulSite )
+{
+    ulSuspendSite = ulSite | criticalSITE_SUSPENDED;
+    ulSuspendStart = configCRITICAL_PROFILER_TIMESTAMP();
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerResume( void )
+{
+    /* Called from inside the critical section of xTaskResumeAll(). */
+    prvRecord( ulSuspendSite, ulSuspendStart );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCriticalProfilerGetSite( UBaseType_t uxIndex,
+                                     CriticalSite_t * pxSite )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    configASSERT( pxSite );
+
+    taskENTER_CRITICAL();
+    {
+        if( uxIndex < uxSitesUsed )
+        {
+            ( void ) memcpy( ( void * ) pxSite, ( const void * ) &( xSites[ uxIndex ] ), sizeof( CriticalSite_t ) );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxCriticalProfilerGetDropped( void )
+{
+    return uxDropped;
+}
+/*-----------------------------------------------------------*/
+
+void vCriticalProfilerClear( void )
+{
+    taskENTER_CRITICAL();
+    {
+        uxSitesUsed = ( UBaseType_t ) 0U;
+        uxDropped = ( UBaseType_t ) 0U;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* configUSE_CRITICAL_PROFILER */
@@ -74,6 +74,24 @@
     #include <reent.h>
 #endif
 
+/* Must be defaulted before trace_recorder.h is included below. */
+#ifndef configUSE_TRACE_RECORDER
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+/* Maps the trace macros left undefined by the application onto the kernel
+ * trace recorder, before they are defaulted below. */
+#include "trace_recorder.h"
+
+/* Must be defaulted before critical_profiler.h is included below. */
+#ifndef configUSE_CRITICAL_PROFILER
+    #define configUSE_CRITICAL_PROFILER    0
+#endif
+
+/* Maps the critical section trace macros left undefined by the application
+ * onto the critical section profiler. */
+#include "critical_profiler.h"
+
 /*
  * Check all the required application specific macros have been defined.
  * These macros are application specific and (as downloaded) are defined
@@ -568,6 +586,65 @@
     #define traceTASK_DELAY()
 #endif
 
+#ifndef traceTASK_RELEASE
+    #define traceTASK_RELEASE( pxTCB )
+#endif
+
+#ifndef traceTASK_DEADLINE_SET
+    #define traceTASK_DEADLINE_SET( pxTCB )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceTASK_DEADLINE_INHERIT
+    #define traceTASK_DEADLINE_INHERIT( pxTCB, xInheritedDeadline )
+#endif
+
+#ifndef traceTASK_DEADLINE_RESTORE
+    #define traceTASK_DEADLINE_RESTORE( pxTCB )
+#endif
+
+#ifndef traceTASK_LET_OVERRUN
+    #define traceTASK_LET_OVERRUN( pxTCB )
+#endif
+
+/* Set to 1 to have the time spent in interrupts and in the scheduler kept
+ * apart from the run time of the tasks, see vTaskGetCpuAccounting(). */
+#ifndef configUSE_CPU_ACCOUNTING
+    #define configUSE_CPU_ACCOUNTING    0
+#endif
+
+/* Called by the port and the application once an interrupt has saved the
+ * context of the task it interrupted, and before that context is restored.
+ * uxIsr numbers the interrupt, from 0 to configACCOUNTING_ISRS - 1. */
+#ifndef traceISR_ENTER
+    #if ( configUSE_CPU_ACCOUNTING == 1 )
+        #define traceISR_ENTER( uxIsr )    vTaskAccountingISREnter( uxIsr )
+    #else
+        #define traceISR_ENTER( uxIsr )
+    #endif
+#endif
+
+#ifndef traceISR_EXIT
+    #if ( configUSE_CPU_ACCOUNTING == 1 )
+        #define traceISR_EXIT()    vTaskAccountingISRExit()
+    #else
+        #define traceISR_EXIT()
+    #endif
+#endif
+
+/* Expanded by the port's portENTER_CRITICAL() once interrupts are masked,
+ * and by its portEXIT_CRITICAL() before they are unmasked. */
+#ifndef traceCRITICAL_ENTER
+    #define traceCRITICAL_ENTER()
+#endif
+
+#ifndef traceCRITICAL_EXIT
+    #define traceCRITICAL_EXIT()
+#endif
+
 #ifndef traceTASK_PRIORITY_SET
     #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )
 #endif
@@ -770,6 +847,37 @@
 
 #endif /* configGENERATE_RUN_TIME_STATS */
 
+/* Number of sliding windows over which the utilisation of each task is kept,
+ * see vTaskGetRunTimeWindow(). */
+#ifndef configRUN_TIME_WINDOWS
+    #define configRUN_TIME_WINDOWS    0
+#endif
+
+#if ( configRUN_TIME_WINDOWS > 0 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configRUN_TIME_WINDOWS needs configGENERATE_RUN_TIME_STATS set to 1
+    #endif
+
+    #ifndef configRUN_TIME_WINDOW_TICKS
+        #error configRUN_TIME_WINDOW_TICKS must list the length of each of the configRUN_TIME_WINDOWS windows in ticks, for example { 1000, 10000 }
+    #endif
+#endif
+
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configUSE_CPU_ACCOUNTING needs configGENERATE_RUN_TIME_STATS set to 1
+    #endif
+
+    #ifndef configACCOUNTING_ISRS
+        #error configACCOUNTING_ISRS must be set to the number of interrupts that call traceISR_ENTER()
+    #endif
+#endif
+
+/* Number the port passes to traceISR_ENTER() from the tick interrupt. */
+#ifndef configTICK_ISR_NUMBER
+    #define configTICK_ISR_NUMBER    0
+#endif
+
 #ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
     #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
@@ -818,6 +926,72 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+/* Set to 1 to include xQueueReserveSlot() and the other functions that let a
+ * task or interrupt work on an item in place in the queue storage area instead
+ * of copying it in and out. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+/* Set to 1 to include xQueueCreateDeadlineOrdered(), which creates queues that
+ * hand out the item with the earliest deadline first rather than the oldest. */
+#ifndef configUSE_DEADLINE_QUEUES
+    #define configUSE_DEADLINE_QUEUES    0
+#endif
+
+/* Set to 1 to have a task that receives from a deadline ordered queue run with
+ * the deadline of the message it is blocked on or serving, when that deadline
+ * is earlier than its own, until it calls vTaskRestoreDeadline() or releases
+ * its next job. */
+#ifndef configUSE_DEADLINE_INHERITANCE
+    #define configUSE_DEADLINE_INHERITANCE    0
+#endif
+
+/* Set to 1 to include vTaskSetLogicalExecution(), which has the kernel latch
+ * the inputs of a periodic task at each release and commit its outputs at each
+ * deadline, and the channels of let.h that carry them. */
+#ifndef configUSE_LOGICAL_EXECUTION_TIME
+    #define configUSE_LOGICAL_EXECUTION_TIME    0
+#endif
+
+/* Set to 1 to have the kernel time every job of the periodic tasks and keep
+ * histograms of the results per task, see vTaskGetJobStats().  Jobs are timed
+ * with configJOB_STATS_TIMESTAMP(), which defaults to the tick count, and
+ * configJOB_STATS_TICKS_TO_TIMESTAMP() converts ticks to its units. */
+#ifndef configUSE_JOB_STATS
+    #define configUSE_JOB_STATS    0
+#endif
+
+#ifndef configJOB_STATS_BUCKETS
+    #define configJOB_STATS_BUCKETS    16
+#endif
+
+#ifndef configJOB_STATS_TIMESTAMP
+    #define configJOB_STATS_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
+#endif
+
+#ifndef configJOB_STATS_TICKS_TO_TIMESTAMP
+    #define configJOB_STATS_TICKS_TO_TIMESTAMP( xTicks )    ( ( uint32_t ) ( xTicks ) )
+#endif
+
+/* Set to 1 to keep the stack high water mark of each task in its TCB, brought
+ * up to date a few words at a time by xTaskStackWatermarkStep(), see
+ * vTaskGetStackReport(). */
+#ifndef configUSE_STACK_WATERMARKS
+    #define configUSE_STACK_WATERMARKS    0
+#endif
+
+/* Margin vTaskGetStackReport() adds to the deepest stack use seen: a
+ * percentage of it, then a number of words, for example for a context an
+ * interrupt saves on the task stack. */
+#ifndef configSTACK_WATERMARK_MARGIN_PERCENT
+    #define configSTACK_WATERMARK_MARGIN_PERCENT    25
+#endif
+
+#ifndef configSTACK_WATERMARK_MARGIN_WORDS
+    #define configSTACK_WATERMARK_MARGIN_WORDS    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -834,6 +1008,75 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+/* Number of TCBs and queues the kernel takes from the fixed block pools in
+ * mempool.c before falling back to pvPortMalloc().  A queue only comes from
+ * its pool when sizeof( StaticQueue_t ) plus its storage area fits in
+ * configMEMPOOL_QUEUE_BLOCK_SIZE bytes. */
+#ifndef configMEMPOOL_TCB_COUNT
+    #define configMEMPOOL_TCB_COUNT    0
+#endif
+
+#ifndef configMEMPOOL_QUEUE_COUNT
+    #define configMEMPOOL_QUEUE_COUNT    0
+#endif
+
+#if ( ( configMEMPOOL_QUEUE_COUNT > 0 ) && !defined( configMEMPOOL_QUEUE_BLOCK_SIZE ) )
+    #error configMEMPOOL_QUEUE_BLOCK_SIZE must be defined when configMEMPOOL_QUEUE_COUNT is not 0
+#endif
+
+/* Scheduling policies that can be selected through configSCHEDULING_POLICY
+ * when configUSE_EDF_SCHEDULER is set to 1.  All of them order the periodic
+ * tasks in a single ready list, they only differ in the key used to sort it. */
+#define schedPOLICY_EDF    1 /* Earliest absolute deadline first. */
+#define schedPOLICY_RM     2 /* Rate monotonic, shortest period first. */
+#define schedPOLICY_DM     3 /* Deadline monotonic, shortest relative deadline first. */
+#define schedPOLICY_LLF    4 /* Least laxity first, needs an execution budget per task. */
+#define schedPOLICY_EDZL   5 /* EDF with zero laxity tasks promoted ahead of the others, needs an execution budget per task. */
+
+#ifndef configUSE_EDF_SCHEDULER
+    #define configUSE_EDF_SCHEDULER    0
+#endif
+
+#ifndef configSCHEDULING_POLICY
+    #define configSCHEDULING_POLICY    schedPOLICY_EDF
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #if ( ( configSCHEDULING_POLICY < schedPOLICY_EDF ) || ( configSCHEDULING_POLICY > schedPOLICY_EDZL ) )
+        #error configSCHEDULING_POLICY must be one of schedPOLICY_EDF, schedPOLICY_RM, schedPOLICY_DM, schedPOLICY_LLF or schedPOLICY_EDZL
+    #endif
+
+    /* Tasks have no priority under EDF, the TCB does not hold one. */
+    #if ( ( INCLUDE_vTaskPrioritySet == 1 ) || ( INCLUDE_uxTaskPriorityGet == 1 ) )
+        #error INCLUDE_vTaskPrioritySet and INCLUDE_uxTaskPriorityGet must be 0 when configUSE_EDF_SCHEDULER is 1
+    #endif
+#endif
+
+#if ( ( configUSE_DEADLINE_INHERITANCE == 1 ) && ( ( configUSE_EDF_SCHEDULER != 1 ) || ( configUSE_DEADLINE_QUEUES != 1 ) ) )
+    #error configUSE_DEADLINE_INHERITANCE needs configUSE_EDF_SCHEDULER and configUSE_DEADLINE_QUEUES set to 1
+#endif
+
+#if ( ( configUSE_LOGICAL_EXECUTION_TIME == 1 ) && ( configUSE_EDF_SCHEDULER != 1 ) )
+    #error configUSE_LOGICAL_EXECUTION_TIME needs configUSE_EDF_SCHEDULER set to 1
+#endif
+
+#if ( configUSE_JOB_STATS == 1 )
+    #if ( configUSE_EDF_SCHEDULER != 1 )
+        #error configUSE_JOB_STATS needs configUSE_EDF_SCHEDULER set to 1
+    #endif
+
+    #if ( configJOB_STATS_BUCKETS < 2 )
+        #error configJOB_STATS_BUCKETS must be at least 2
+    #endif
+#endif
+
+/* Under schedPOLICY_LLF a task only preempts the running task from the tick
+ * interrupt if its laxity is smaller by more than this number of ticks.
+ * Without it two jobs with equal laxity take turns on every tick. */
+#ifndef configLAXITY_HYSTERESIS_TICKS
+    #define configLAXITY_HYSTERESIS_TICKS    2
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -1185,7 +1428,17 @@ typedef struct xSTATIC_TCB
         xMPU_SETTINGS xDummy2;
     #endif
     StaticListItem_t xDummy3[ 2 ];
-    UBaseType_t uxDummy5;
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        TickType_t xDummy23[ 3 ];
+        #if ( ( configSCHEDULING_POLICY == schedPOLICY_LLF ) || ( configSCHEDULING_POLICY == schedPOLICY_EDZL ) )
+            TickType_t xDummy25[ 2 ];
+        #endif
+        #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+            TickType_t xDummy27;
+        #endif
+    #else
+        UBaseType_t uxDummy5;
+    #endif
     void * pxDummy6;
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
@@ -1198,7 +1451,10 @@ typedef struct xSTATIC_TCB
         UBaseType_t uxDummy10[ 2 ];
     #endif
     #if ( configUSE_MUTEXES == 1 )
-        UBaseType_t uxDummy12[ 2 ];
+        #if ( configUSE_EDF_SCHEDULER == 0 )
+            UBaseType_t uxDummy11;
+        #endif
+        UBaseType_t uxDummy12;
     #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
@@ -1208,6 +1464,10 @@ typedef struct xSTATIC_TCB
     #endif
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
+        #if ( configRUN_TIME_WINDOWS > 0 )
+            configRUN_TIME_COUNTER_TYPE ulDummy32[ 2 ][ configRUN_TIME_WINDOWS ];
+            UBaseType_t uxDummy33[ configRUN_TIME_WINDOWS ];
+        #endif
     #endif
     #if ( configUSE_NEWLIB_REENTRANT == 1 )
         struct  _reent xDummy17;
@@ -1223,9 +1483,42 @@ typedef struct xSTATIC_TCB
     #if ( INCLUDE_xTaskAbortDelay == 1 )
         uint8_t ucDummy21;
     #endif
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+            uint8_t ucDummy26;
+        #endif
+        #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+            uint8_t ucDummy28;
+        #endif
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            uint8_t ucDummy31;
+        #endif
+        #if ( configUSE_JOB_STATS == 1 )
+            uint8_t ucDummy37;
+        #endif
+    #endif
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_STACK_WATERMARKS == 1 )
+        configSTACK_DEPTH_TYPE uxDummy38[ 3 ];
+    #endif
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+        UBaseType_t uxDummy39;
+        uint32_t ulDummy40;
+    #endif
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        UBaseType_t uxDummy24;
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            TickType_t xDummy29[ 2 ];
+            void * pxDummy30;
+        #endif
+        #if ( configUSE_JOB_STATS == 1 )
+            uint32_t ulDummy34[ 3 ];
+            UBaseType_t uxDummy35[ 3 ];
+            uint16_t usDummy36[ 4 ][ configJOB_STATS_BUCKETS ];
+        #endif
+    #endif
 } StaticTask_t;
 
 /*
@@ -1268,6 +1561,15 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        void * pvDummy10[ 2 ];
+    #endif
+
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        void * pvDummy11;
+        uint8_t ucDummy12;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -0,0 +1,187 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Critical section and scheduler suspension profiler.
+ *
+ * With configUSE_CRITICAL_PROFILER set to 1 the port's portENTER_CRITICAL()
+ * and portEXIT_CRITICAL(), and vTaskSuspendAll() and xTaskResumeAll(), time
+ * how long interrupts stay masked and the scheduler stays suspended.  Each
+ * duration is charged to the call site that started it, the outermost
+ * portENTER_CRITICAL() or vTaskSuspendAll(), which keeps the longest duration
+ * seen and a log2 histogram of all of them.  Durations are in
+ * configCRITICAL_PROFILER_TIMESTAMP() units, which should be a counter much
+ * faster than the tick.
+ *
+ * A call site is the line it is on and the criticalFILE_ID of its source file.
+ * A source file sets its ID by defining criticalFILE_ID before it includes
+ * FreeRTOS.h, files that do not are reported as criticalFILE_UNKNOWN.  The
+ * kernel files use the IDs below, application files number themselves from
+ * criticalFILE_APPLICATION.
+ *
+ * The profiler takes the end time before it looks the call site up, so the
+ * look up is not part of the duration, but it does add to the time interrupts
+ * are masked while profiling.  The nesting is kept per task: a task that
+ * yields inside a critical section ends its duration at the context switch,
+ * since the task switched in may run with interrupts enabled, and starts a new
+ * one for the same call site when it is switched back in.
+ *
+ * This header is included by FreeRTOS.h before the trace macros are defaulted,
+ * and only defines those the application left undefined.
+ */
+
+#ifndef CRITICAL_PROFILER_H
+#define CRITICAL_PROFILER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include critical_profiler.h"
+#endif
+
+/* Source file IDs, the host decoder keeps the same list. */
+#define criticalFILE_UNKNOWN          0
+#define criticalFILE_TASKS            1
+#define criticalFILE_QUEUE            2
+#define criticalFILE_STREAM_BUFFER    3
+#define criticalFILE_TIMERS           4
+#define criticalFILE_EVENT_GROUPS     5
+#define criticalFILE_MEMPOOL          6
+#define criticalFILE_LET              7
+#define criticalFILE_HEAP             8
+#define criticalFILE_APPLICATION      16
+
+#ifndef criticalFILE_ID
+    #define criticalFILE_ID    criticalFILE_UNKNOWN
+#endif
+
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+    #error configUSE_CRITICAL_PROFILER replaces vTaskSuspendAll() with a macro, which the MPU wrappers would rename
+#endif
+
+#ifndef configCRITICAL_PROFILER_TIMESTAMP
+    #error configCRITICAL_PROFILER_TIMESTAMP() must be defined in FreeRTOSConfig.h to read a counter much faster than the tick
+#endif
+
+/* The value configCRITICAL_PROFILER_TIMESTAMP() wraps at, or 0 if it runs
+ * through all 32 bits.  Durations longer than a period are not told apart from
+ * shorter ones. */
+#ifndef configCRITICAL_PROFILER_TIMESTAMP_PERIOD
+    #define configCRITICAL_PROFILER_TIMESTAMP_PERIOD    0UL
+#endif
+
+/* Number of call sites kept, durations from further call sites are only
+ * counted by uxCriticalProfilerGetDropped(). */
+#ifndef configCRITICAL_PROFILER_SITES
+    #define configCRITICAL_PROFILER_SITES    24
+#endif
+
+/* Bucket 0 counts durations of 0, bucket n those from 2^(n-1) to 2^n - 1, the
+ * last bucket also everything longer. */
+#ifndef configCRITICAL_PROFILER_BUCKETS
+    #define configCRITICAL_PROFILER_BUCKETS    16
+#endif
+
+#if ( criticalFILE_ID > 0x7FFF )
+    #error criticalFILE_ID must fit in 15 bits
+#endif
+
+/* The call site the macro is expanded at. */
+#define criticalSITE()            ( ( ( uint32_t ) ( criticalFILE_ID ) << 16 ) | ( ( uint32_t ) __LINE__ & 0xFFFFUL ) )
+
+/* Set in ulSite for a scheduler suspension rather than a critical section. */
+#define criticalSITE_SUSPENDED    ( ( uint32_t ) 0x80000000UL )
+
+typedef struct xCRITICAL_SITE
+{
+    uint32_t ulSite;                                          /*< criticalFILE_ID in bits 16 to 30 and the line in the low 16 bits, ored with criticalSITE_SUSPENDED for a vTaskSuspendAll() call. */
+    uint32_t ulMaxDuration;                                   /*< Longest duration seen. */
+    uint32_t ulCount;                                         /*< Number of durations seen. */
+    uint16_t usHistogram[ configCRITICAL_PROFILER_BUCKETS ]; /*< Durations per log2 bucket, each count stops at 0xFFFF. */
+} CriticalSite_t;
+
+/**
+ * critical_profiler.h
+ * @code{c}
+ * BaseType_t xCriticalProfilerGetSite( UBaseType_t uxIndex, CriticalSite_t * pxSite );
+ * UBaseType_t uxCriticalProfilerGetDropped( void );
+ * void vCriticalProfilerClear( void );
+ * @endcode
+ *
+ * xCriticalProfilerGetSite() copies the uxIndex call site seen, counting from
+ * 0 in the order they were first seen, to pxSite and returns pdTRUE, or returns
+ * pdFALSE if fewer call sites were seen.  uxCriticalProfilerGetDropped()
+ * returns the number of durations not kept because the table was full, and
+ * vCriticalProfilerClear() forgets every call site.
+ */
+BaseType_t xCriticalProfilerGetSite( UBaseType_t uxIndex,
+                                     CriticalSite_t * pxSite ) PRIVILEGED_FUNCTION;
+UBaseType_t uxCriticalProfilerGetDropped( void ) PRIVILEGED_FUNCTION;
+void vCriticalProfilerClear( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * vCriticalProfilerEnter() and vCriticalProfilerExit() are used by the trace
+ * macros below and must be called with interrupts masked.
+ * vCriticalProfilerSuspend() and vCriticalProfilerResume() are called by
+ * tasks.c when the scheduler is suspended by the outermost vTaskSuspendAll(),
+ * and when it is resumed.  uxCriticalProfilerSwitchOut() ends the duration of
+ * the task being switched out, returning its nesting and call site for its TCB
+ * to keep, and vCriticalProfilerSwitchIn() restores those of the task being
+ * switched in.
+ */
+void vCriticalProfilerEnter( uint32_t ulSite ) PRIVILEGED_FUNCTION;
+void vCriticalProfilerExit( void ) PRIVILEGED_FUNCTION;
+void vCriticalProfilerSuspend( uint32_t ulSite ) PRIVILEGED_FUNCTION;
+void vCriticalProfilerResume( void ) PRIVILEGED_FUNCTION;
+UBaseType_t uxCriticalProfilerSwitchOut( uint32_t * pulSite ) PRIVILEGED_FUNCTION;
+void vCriticalProfilerSwitchIn( UBaseType_t uxDepth,
+                                uint32_t ulSite ) PRIVILEGED_FUNCTION;
+
+#ifndef traceCRITICAL_ENTER
+    #define traceCRITICAL_ENTER()    vCriticalProfilerEnter( criticalSITE() )
+#endif
+
+#ifndef traceCRITICAL_EXIT
+    #define traceCRITICAL_EXIT()    vCriticalProfilerExit()
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* configUSE_CRITICAL_PROFILER */
+
+#endif /* CRITICAL_PROFILER_H */
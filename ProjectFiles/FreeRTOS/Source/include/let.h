@@ -0,0 +1,143 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Logical execution time channels.
+ *
+ * A task put in logical execution time (LET) mode with
+ * vTaskSetLogicalExecution() has its inputs latched by the kernel when each
+ * job is released, and its outputs committed by the kernel at the absolute
+ * deadline of the job, whenever the job actually ran in between.  What other
+ * tasks and devices see of the task therefore changes at fixed instants only.
+ *
+ * Data is carried by channels of one writer and one reader.  A channel holds
+ * three slots of one item each: the one last committed, the one the reader
+ * latched, and the one the writer is filling.  The kernel only ever swaps slot
+ * indexes, so neither side copies data or takes a lock, and a slot never
+ * changes while a job is using it.  The reader is either a LET task, or, for
+ * outputs to a device, a commit hook called from the tick interrupt with the
+ * slot just committed.  The slot handed to the hook is left untouched until
+ * the next commit.
+ */
+
+#ifndef LET_H
+#define LET_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include let.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Number of items the storage of a channel must hold. */
+#define letCHANNEL_SLOTS    3
+
+/*
+ * Called from the tick interrupt with the slot a channel has just committed.
+ */
+typedef void (* LetCommitHook_t)( void * pvItem );
+
+/*
+ * The channel itself.  Only declared here so channels can be allocated
+ * statically, the members must not be accessed directly.
+ */
+typedef struct xLET_CHANNEL
+{
+    uint8_t * pucStorage;           /*< letCHANNEL_SLOTS items of uxItemSize bytes. */
+    UBaseType_t uxItemSize;         /*< Size of each item. */
+    TaskHandle_t xWriter;           /*< Task whose outputs are committed to the channel. */
+    TaskHandle_t xReader;           /*< Task whose inputs are latched from the channel, NULL if pxCommitHook is used. */
+    LetCommitHook_t pxCommitHook;   /*< Called with the committed item when there is no reader task. */
+    struct xLET_CHANNEL * pxNext;   /*< Next channel known to the kernel. */
+    uint8_t ucCommitted;            /*< Slot last committed by the writer. */
+    uint8_t ucLatched;              /*< Slot latched by the reader, or handed to pxCommitHook. */
+    uint8_t ucWriting;              /*< Slot the writer is filling. */
+} LetChannel_t;
+
+/**
+ * let.h
+ * @code{c}
+ * void vLetChannelInitialise( LetChannel_t * pxChannel, void * pvStorage, UBaseType_t uxItemSize, TaskHandle_t xWriter, TaskHandle_t xReader, LetCommitHook_t pxCommitHook );
+ * @endcode
+ *
+ * Initialises a channel and makes it known to the kernel.  All three slots
+ * start as copies of the first item of pvStorage, which the reader sees until
+ * the writer commits its first job.
+ *
+ * @param pvStorage Storage for letCHANNEL_SLOTS items of uxItemSize bytes,
+ * suitably aligned for the item type.
+ *
+ * @param xWriter The task that writes to the channel.  Must be a LET task.
+ *
+ * @param xReader The task that reads from the channel, which must be a LET
+ * task, or NULL if the channel feeds pxCommitHook.
+ *
+ * @param pxCommitHook Called from the tick interrupt each time the writer
+ * commits, when xReader is NULL.  Otherwise NULL.
+ */
+void vLetChannelInitialise( LetChannel_t * pxChannel,
+                            void * pvStorage,
+                            UBaseType_t uxItemSize,
+                            TaskHandle_t xWriter,
+                            TaskHandle_t xReader,
+                            LetCommitHook_t pxCommitHook ) PRIVILEGED_FUNCTION;
+
+/**
+ * let.h
+ * @code{c}
+ * void * pvLetChannelWriteBuffer( LetChannel_t * pxChannel );
+ * const void * pvLetChannelReadBuffer( const LetChannel_t * pxChannel );
+ * @endcode
+ *
+ * Return the item the current job of the writer fills, and the item the
+ * current job of the reader latched at its release.  Both stay the same until
+ * the job completes.  The item being written keeps whatever was written to it
+ * two commits before, so the writer must set every field it uses.
+ */
+void * pvLetChannelWriteBuffer( LetChannel_t * pxChannel ) PRIVILEGED_FUNCTION;
+const void * pvLetChannelReadBuffer( const LetChannel_t * pxChannel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the kernel at the LET instants of xTask.  Commits the item written
+ * to, or latches the item read from, every channel of xTask.  Called from the
+ * tick interrupt, or with the scheduler suspended.
+ */
+void vLetCommitOutputs( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+void vLetLatchInputs( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* LET_H */
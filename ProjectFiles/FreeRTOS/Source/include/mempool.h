@@ -0,0 +1,257 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Fixed size block pools.
+ *
+ * A pool hands out blocks of one size from an array reserved at compile time.
+ * Allocating and freeing a block take a constant, short time, can be done
+ * from an interrupt, and never fragment memory.  Blocks that have never been
+ * handed out are taken from the end of the array in order, blocks that are
+ * freed are kept on a singly linked free list threaded through the blocks
+ * themselves, so a pool needs no initialisation at run time.
+ *
+ * Pools are defined with mempoolDEFINE() or initialised at run time with
+ * vMemPoolInitialise().  When configMEMPOOL_TCB_COUNT or
+ * configMEMPOOL_QUEUE_COUNT are set in FreeRTOSConfig.h the kernel takes TCBs
+ * and queue storage from the xMemPoolTCB and xMemPoolQueue pools, and only
+ * falls back to pvPortMalloc() when the pool is empty or, for queues, the
+ * storage does not fit in a block.
+ */
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include mempool.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * Used to align the storage of a pool to portBYTE_ALIGNMENT.
+ */
+typedef union xMEMPOOL_ALIGN
+{
+    void * pvDummy;
+    uint32_t ulDummy;
+    #if ( portBYTE_ALIGNMENT >= 8 )
+        uint64_t ullDummy;
+    #endif
+} MemPoolAlign_t;
+
+/*
+ * The pool itself.  Only declared here so pools can be defined statically
+ * with mempoolDEFINE(), the members must not be accessed directly.
+ */
+typedef struct xMEMPOOL
+{
+    const char * pcName;                      /*< Name of the pool, to identify it in reports. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    uint8_t * pucStorage;                     /*< Start of the array the blocks are taken from. */
+    size_t xBlockSize;                        /*< Size of each block, a multiple of portBYTE_ALIGNMENT. */
+    UBaseType_t uxBlockCount;                 /*< Number of blocks in the pool. */
+    UBaseType_t uxNeverUsedBlocks;            /*< Blocks at the end of the array that have never been handed out. */
+    void * pvFreeList;                        /*< Blocks that have been freed, each holding the address of the next. */
+    UBaseType_t uxFreeBlocks;                 /*< Number of blocks that can be allocated now. */
+    UBaseType_t uxMinimumEverFreeBlocks;      /*< The lowest uxFreeBlocks has been. */
+    UBaseType_t uxNumberOfAllocations;        /*< Successful allocations. */
+    UBaseType_t uxNumberOfFailedAllocations;  /*< Allocations that failed because the pool was empty. */
+} MemPool_t;
+
+typedef MemPool_t * MemPoolHandle_t;
+
+/*
+ * Used to pass information about a pool out of vMemPoolGetStats().
+ */
+typedef struct xMEMPOOL_STATS
+{
+    const char * pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    size_t xBlockSize;
+    UBaseType_t uxBlockCount;
+    UBaseType_t uxFreeBlocks;
+    UBaseType_t uxMinimumEverFreeBlocks;
+    UBaseType_t uxNumberOfAllocations;
+    UBaseType_t uxNumberOfFailedAllocations;
+} MemPoolStats_t;
+
+/*
+ * Size of each block of a pool that holds objects of xObjectSize bytes.  The
+ * block must be able to hold a pointer while it is free.
+ */
+#define mempoolBLOCK_SIZE( xObjectSize )                                                                        \
+    ( ( ( ( xObjectSize ) < sizeof( void * ) ? sizeof( void * ) : ( xObjectSize ) ) + ( portBYTE_ALIGNMENT - 1 ) ) \
+      & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*
+ * Number of MemPoolAlign_t needed to hold uxBlockCount blocks.
+ */
+#define mempoolSTORAGE_LENGTH( xObjectSize, uxBlockCount ) \
+    ( ( ( ( uxBlockCount ) * mempoolBLOCK_SIZE( xObjectSize ) ) + ( sizeof( MemPoolAlign_t ) - 1 ) ) / sizeof( MemPoolAlign_t ) )
+
+/**
+ * mempool.h
+ * @code{c}
+ * mempoolDEFINE( xPool, pcName, xObjectSize, uxBlockCount );
+ * @endcode
+ *
+ * Defines a pool called xPool, along with the storage for its blocks, that is
+ * ready to use without any run time initialisation.  The pool can be shared
+ * between files by declaring it extern MemPool_t xPool, the storage is only
+ * visible in the file that defines the pool.
+ *
+ * @param xPool The name of the MemPool_t variable.  Pass &xPool to the other
+ * functions.
+ *
+ * @param pcName A text name for the pool, used in reports.
+ *
+ * @param xObjectSize The size of the objects held in the pool, normally
+ * sizeof() the type.
+ *
+ * @param uxBlockCount The number of objects the pool can hold.
+ *
+ * Example usage:
+ * @code{c}
+ * mempoolDEFINE( xMessagePool, "Msg", sizeof( Message_t ), 8 );
+ *
+ * Message_t * pxMessage = ( Message_t * ) pvMemPoolAlloc( &xMessagePool );
+ * @endcode
+ */
+#define mempoolDEFINE( xPool, pcPoolName, xObjectSize, uxBlockCount )                                         \
+    static MemPoolAlign_t xPool ## _Storage[ mempoolSTORAGE_LENGTH( ( xObjectSize ), ( uxBlockCount ) ) ];     \
+    MemPool_t xPool =                                                                                         \
+    {                                                                                                         \
+        ( pcPoolName ), ( uint8_t * ) xPool ## _Storage, mempoolBLOCK_SIZE( xObjectSize ), ( uxBlockCount ), \
+        ( uxBlockCount ), NULL, ( uxBlockCount ), ( uxBlockCount ), 0, 0                                      \
+    }
+
+/**
+ * mempool.h
+ * @code{c}
+ * void vMemPoolInitialise( MemPool_t * pxPool, const char * pcName, void * pvStorage, size_t xObjectSize, UBaseType_t uxBlockCount );
+ * @endcode
+ *
+ * Initialises a pool at run time.  pvStorage must be aligned to
+ * portBYTE_ALIGNMENT and hold at least
+ * uxBlockCount * mempoolBLOCK_SIZE( xObjectSize ) bytes.  Must not be called
+ * while the pool is in use.
+ */
+void vMemPoolInitialise( MemPool_t * pxPool,
+                         const char * pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                         void * pvStorage,
+                         size_t xObjectSize,
+                         UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ * @code{c}
+ * void * pvMemPoolAlloc( MemPoolHandle_t xPool );
+ * void * pvMemPoolAllocFromISR( MemPoolHandle_t xPool );
+ * @endcode
+ *
+ * Takes a block from a pool.  pvMemPoolAllocFromISR() is the version that can
+ * be called from an interrupt service routine.
+ *
+ * @return A pointer to the block, or NULL if the pool is empty.
+ */
+void * pvMemPoolAlloc( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ * @code{c}
+ * void vMemPoolFree( MemPoolHandle_t xPool, void * pvBlock );
+ * void vMemPoolFreeFromISR( MemPoolHandle_t xPool, void * pvBlock );
+ * @endcode
+ *
+ * Returns a block obtained from pvMemPoolAlloc() or pvMemPoolAllocFromISR()
+ * to the same pool.  vMemPoolFreeFromISR() is the version that can be called
+ * from an interrupt service routine.
+ */
+void vMemPoolFree( MemPoolHandle_t xPool,
+                   void * pvBlock ) PRIVILEGED_FUNCTION;
+void vMemPoolFreeFromISR( MemPoolHandle_t xPool,
+                          void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ * @code{c}
+ * BaseType_t xMemPoolContains( MemPoolHandle_t xPool, const void * pvBlock );
+ * @endcode
+ *
+ * @return pdTRUE if pvBlock is a block of xPool, otherwise pdFALSE.
+ */
+BaseType_t xMemPoolContains( MemPoolHandle_t xPool,
+                             const void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * mempool.h
+ * @code{c}
+ * void vMemPoolGetStats( MemPoolHandle_t xPool, MemPoolStats_t * pxStats );
+ * @endcode
+ *
+ * Copies the current state and the usage statistics of a pool into pxStats.
+ */
+void vMemPoolGetStats( MemPoolHandle_t xPool,
+                       MemPoolStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the kernel.  Allocates xSize bytes from xPool if the pool is not
+ * empty and the block is large enough, otherwise from the heap with
+ * pvPortMallocCategory().  The block must be freed with
+ * vMemPoolFreeWithFallback() on the same pool.  Can not be called from an
+ * interrupt.
+ */
+void * pvMemPoolAllocWithFallback( MemPoolHandle_t xPool,
+                                   size_t xSize,
+                                   UBaseType_t uxCategory ) PRIVILEGED_FUNCTION;
+void vMemPoolFreeWithFallback( MemPoolHandle_t xPool,
+                               void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pools the kernel takes its objects from, see configMEMPOOL_TCB_COUNT and
+ * configMEMPOOL_QUEUE_COUNT.
+ */
+#if ( configMEMPOOL_TCB_COUNT > 0 )
+    extern MemPool_t xMemPoolTCB;
+#endif
+
+#if ( configMEMPOOL_QUEUE_COUNT > 0 )
+    extern MemPool_t xMemPoolQueue;
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* MEMPOOL_H */
@@ -90,6 +90,13 @@
     #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP    0
 #endif
 
+#ifndef configUSE_HEAP_CATEGORIES
+    /* Set to 1 to have the kernel tell the heap what each allocation is for.
+     * Needs a heap that implements pvPortMallocCategory(), such as
+     * heap_arena.c. */
+    #define configUSE_HEAP_CATEGORIES    0
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -148,6 +155,7 @@ typedef struct xHeapStats
     size_t xMinimumEverFreeBytesRemaining;  /* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
     size_t xNumberOfSuccessfulAllocations;  /* The number of calls to pvPortMalloc() that have returned a valid memory block. */
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
+    size_t xFragmentationPercent;           /* The share of the free memory, in percent, that can not be returned by a single call to pvPortMalloc(): 100 * ( 1 - largest free block / available heap space ). */
 } HeapStats_t;
 
 /*
@@ -178,12 +186,40 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * What an allocation made by the kernel is used for.  Allocations made
+ * through pvPortMalloc() count as portHEAP_CATEGORY_OTHER.
+ */
+#define portHEAP_CATEGORY_OTHER    ( ( UBaseType_t ) 0 )
+#define portHEAP_CATEGORY_TCB      ( ( UBaseType_t ) 1 )
+#define portHEAP_CATEGORY_STACK    ( ( UBaseType_t ) 2 )
+#define portHEAP_CATEGORY_QUEUE    ( ( UBaseType_t ) 3 )
+#define portHEAP_CATEGORY_COUNT    ( 4 )
+
+#if ( configUSE_HEAP_CATEGORIES == 1 )
+    void * pvPortMallocCategory( size_t xSize,
+                                 UBaseType_t uxCategory ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of bytes of heap, alignment padding included, taken by
+ * the allocations made in uxCategory.
+ */
+    size_t xPortGetHeapCategoryUsage( UBaseType_t uxCategory ) PRIVILEGED_FUNCTION;
+#else
+    #define pvPortMallocCategory( xSize, uxCategory )    pvPortMalloc( xSize )
+#endif
+
+/*
+ * Stops the heap handing out any more memory.  Only provided by heap_arena.c.
+ */
+void vPortHeapLock( void ) PRIVILEGED_FUNCTION;
+
 #if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
     void * pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
     void vPortFreeStack( void * pv ) PRIVILEGED_FUNCTION;
 #else
-    #define pvPortMallocStack    pvPortMalloc
-    #define vPortFreeStack       vPortFree
+    #define pvPortMallocStack( xSize )    pvPortMallocCategory( ( xSize ), portHEAP_CATEGORY_STACK )
+    #define vPortFreeStack                vPortFree
 #endif
 
 /*
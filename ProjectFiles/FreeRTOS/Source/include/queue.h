@@ -69,6 +69,15 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
 #define queueOVERWRITE                        ( ( BaseType_t ) 2 )
 
+/* What a deadline ordered queue does when an item is sent to it while it is
+ * full, see xQueueCreateDeadlineOrdered(). */
+#define queueOVERFLOW_REJECT_NEWEST           ( ( uint8_t ) 0U )
+#define queueOVERFLOW_EVICT_LATEST            ( ( uint8_t ) 1U )
+
+/* Returned by xQueueSendWithDeadline() when the item was queued in place of
+ * the item with the latest deadline. */
+#define queueITEM_EVICTED                     ( ( BaseType_t ) 2 )
+
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
 #define queueQUEUE_TYPE_SET                   ( ( uint8_t ) 0U )
@@ -1418,6 +1427,343 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReserveSlot(
+ *                               QueueHandle_t xQueue,
+ *                               void **ppvSlot,
+ *                               TickType_t xTicksToWait
+ *                            );
+ * @endcode
+ *
+ * Zero copy alternative to xQueueSendToBack().  Instead of copying an item
+ * into the queue, hands out a pointer to the slot the next item will occupy so
+ * the caller can build the item in place, then vQueueCommitSlot() adds it to
+ * the queue.  Blocks and times out in the same way as xQueueSendToBack().
+ *
+ * Only one slot of a queue can be reserved at a time.  While it is reserved
+ * the queue looks full to every other sender, so keep the time between
+ * reserving and committing short.  Cannot be used on a queue that is a member
+ * of a queue set.  configUSE_QUEUE_ZERO_COPY must be set to 1 in
+ * FreeRTOSConfig.h for these functions to be available.
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param ppvSlot Set to the start of the reserved slot, which is uxItemSize
+ * bytes long and aligned as the queue storage area allows.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to become available.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vProducer( QueueHandle_t xQueue )
+ * {
+ * message_t *pxMessage;
+ *
+ *  if( xQueueReserveSlot( xQueue, ( void ** ) &pxMessage, 10 ) == pdPASS )
+ *  {
+ *      pxMessage->ucMessageID = 1;
+ *      vQueueCommitSlot( xQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueReserveSlot xQueueReserveSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReserveSlot( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of xQueueReserveSlot() that can be called from an ISR.  Never
+ * blocks.
+ */
+BaseType_t xQueueReserveSlotFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the slot reserved by xQueueReserveSlot() to the back of the queue,
+ * waking a task waiting to receive from the queue in the same way as
+ * xQueueSendToBack().  Must be called exactly once per reserved slot.
+ */
+void vQueueCommitSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of vQueueCommitSlot() that can be called from an ISR.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if a context switch should be
+ * requested before the interrupt exits.
+ */
+void vQueueCommitSlotFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekSlot(
+ *                            QueueHandle_t xQueue,
+ *                            void **ppvSlot,
+ *                            TickType_t xTicksToWait
+ *                         );
+ * @endcode
+ *
+ * Zero copy alternative to xQueueReceive().  Hands out a pointer to the item at
+ * the head of the queue so the caller can use it in place.  The item stays in
+ * the queue, and its slot can not be reused, until vQueueReleaseSlot() removes
+ * it.  Blocks and times out in the same way as xQueueReceive().
+ *
+ * Only the head item of a queue can be held at a time.  While it is held
+ * xQueueReceive() and xQueuePeekSlot() block as if the queue were empty, and
+ * items can not be sent to the front of the queue or overwrite it.
+ * xQueuePeek() and sending to the back of the queue are unaffected.
+ *
+ * @param xQueue The handle to the queue from which the item is to be received.
+ *
+ * @param ppvSlot Set to the start of the head item.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to become available.
+ *
+ * @return pdPASS if the head item is now held, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+ * @code{c}
+ * void vConsumer( QueueHandle_t xQueue )
+ * {
+ * message_t *pxMessage;
+ *
+ *  if( xQueuePeekSlot( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdPASS )
+ *  {
+ *      vSerialPutString( pxMessage->ucData, MESSAGE_BUFFER_SIZE );
+ *      vQueueReleaseSlot( xQueue );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueuePeekSlot xQueuePeekSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeekSlot( QueueHandle_t xQueue,
+                           void ** const ppvSlot,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of xQueuePeekSlot() that can be called from an ISR.  Never blocks.
+ */
+BaseType_t xQueuePeekSlotFromISR( QueueHandle_t xQueue,
+                                  void ** const ppvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the item held by xQueuePeekSlot() from the queue, waking a task
+ * waiting to send to the queue in the same way as xQueueReceive().  The slot
+ * must not be accessed after it has been released.
+ */
+void vQueueReleaseSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of vQueueReleaseSlot() that can be called from an ISR.
+ */
+void vQueueReleaseSlotFromISR( QueueHandle_t xQueue,
+                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueSendMultiple(
+ *                                  QueueHandle_t xQueue,
+ *                                  const void *pvItems,
+ *                                  UBaseType_t uxItemCount,
+ *                                  TickType_t xTicksToWait
+ *                               );
+ * @endcode
+ *
+ * Posts up to uxItemCount items, stored back to back in pvItems, to the back
+ * of a queue.  Blocks, for at most xTicksToWait ticks, only until there is
+ * space for one item, then posts as many items as fit.  All the items are
+ * copied, and the tasks waiting to receive unblocked, from one critical
+ * section, so a batch costs one kernel entry and at most one context switch
+ * rather than one per item.
+ *
+ * Cannot be used on a queue that is a member of a queue set.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems The items to post.
+ *
+ * @param uxItemCount The number of items in pvItems.  Must not be 0.
+ *
+ * @return The number of items posted, which is 0 if the block time expired
+ * before there was any space in the queue.
+ *
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItems,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueReceiveMultiple(
+ *                                     QueueHandle_t xQueue,
+ *                                     void *pvBuffer,
+ *                                     UBaseType_t uxMaxItems,
+ *                                     TickType_t xTicksToWait
+ *                                  );
+ * @endcode
+ *
+ * Receives up to uxMaxItems items from the front of a queue into pvBuffer,
+ * oldest first.  Blocks, for at most xTicksToWait ticks, only until the queue
+ * holds one item, then takes as many as are there.  As with
+ * uxQueueSendMultiple() the whole batch is handled in one critical section.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The most items to receive.  Must not be 0.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * while the queue was empty.
+ *
+ * Example usage:
+ * @code{c}
+ * void vConsumer( QueueHandle_t xQueue )
+ * {
+ * message_t *pxMessages[ 4 ];
+ * UBaseType_t uxCount, ux;
+ *
+ *  uxCount = uxQueueReceiveMultiple( xQueue, pxMessages, 4, portMAX_DELAY );
+ *
+ *  for( ux = 0; ux < uxCount; ux++ )
+ *  {
+ *      // Process pxMessages[ ux ].
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateDeadlineOrdered(
+ *                                            UBaseType_t uxQueueLength,
+ *                                            UBaseType_t uxItemSize,
+ *                                            uint8_t ucOverflowPolicy
+ *                                         );
+ * @endcode
+ *
+ * Creates a queue that is not FIFO: every item is sent with an absolute
+ * deadline, using xQueueSendWithDeadline(), and xQueueReceive(), xQueuePeek()
+ * and uxQueueReceiveMultiple() always return the item with the earliest
+ * deadline.  The items are kept in a binary heap, so sending and receiving
+ * take O(log uxQueueLength) time.  Items with the same deadline are not
+ * guaranteed to be received in the order they were sent.
+ *
+ * The other send functions, and the zero copy functions, can not be used on a
+ * deadline ordered queue.  configUSE_DEADLINE_QUEUES must be set to 1 in
+ * FreeRTOSConfig.h for these functions to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * The queue also uses sizeof( TickType_t ) + sizeof( UBaseType_t ) bytes per
+ * item to order the items.
+ *
+ * @param ucOverflowPolicy What happens when an item is sent while the queue is
+ * full.  With queueOVERFLOW_REJECT_NEWEST the sender waits for space, as with
+ * a FIFO queue.  With queueOVERFLOW_EVICT_LATEST the item with the latest
+ * deadline is dropped to make room, unless the new item would itself have the
+ * latest deadline, in which case the sender waits for space.
+ *
+ * @return The handle of the created queue, or NULL if the queue could not be
+ * created.
+ *
+ * \defgroup xQueueCreateDeadlineOrdered xQueueCreateDeadlineOrdered
+ * \ingroup QueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize,
+                                               const uint8_t ucOverflowPolicy ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithDeadline(
+ *                                    QueueHandle_t xQueue,
+ *                                    const void *pvItemToQueue,
+ *                                    TickType_t xDeadline,
+ *                                    void *pvEvictedItem,
+ *                                    TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Posts an item to a queue created by xQueueCreateDeadlineOrdered().
+ *
+ * @param xQueue The handle to the queue on which the item is to be posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param xDeadline The absolute deadline of the item, in ticks.  Deadlines are
+ * compared modulo the tick count wrap, so must be within portMAX_DELAY / 2
+ * ticks of each other.
+ *
+ * @param pvEvictedItem Buffer the evicted item is copied to when the queue
+ * overflow policy is queueOVERFLOW_EVICT_LATEST, so the caller can release
+ * anything it refers to.  Can be NULL.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue.
+ *
+ * @return pdPASS if the item was posted, queueITEM_EVICTED if it was posted in
+ * place of the item copied to pvEvictedItem, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vProducer( QueueHandle_t xQueue, message_t *pxMessage )
+ * {
+ * message_t *pxEvicted;
+ *
+ *  if( xQueueSendWithDeadline( xQueue, &pxMessage, xTaskGetTickCount() + 20,
+ *                              &pxEvicted, 0 ) == queueITEM_EVICTED )
+ *  {
+ *      vMemPoolFree( &xMessagePool, pxEvicted );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendWithDeadline xQueueSendWithDeadline
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendWithDeadline( QueueHandle_t xQueue,
+                                   const void * const pvItemToQueue,
+                                   const TickType_t xDeadline,
+                                   void * const pvEvictedItem,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Version of xQueueSendWithDeadline() that can be called from an ISR.  Never
+ * blocks.
+ */
+BaseType_t xQueueSendWithDeadlineFromISR( QueueHandle_t xQueue,
+                                          const void * const pvItemToQueue,
+                                          const TickType_t xDeadline,
+                                          void * const pvEvictedItem,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
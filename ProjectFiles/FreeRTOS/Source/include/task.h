@@ -149,6 +149,24 @@ typedef struct xTASK_PARAMETERS
     #endif
 } TaskParameters_t;
 
+/*
+ * Parameters required to create a periodic task from a task table, see
+ * xTaskPeriodicCreateTable().
+ */
+typedef struct xPERIODIC_TASK_PARAMETERS
+{
+    TaskFunction_t pvTaskCode;
+    const char * pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    TickType_t xPeriod;
+    TickType_t xRelativeDeadline;
+    TickType_t xExecutionBudget;
+    configSTACK_DEPTH_TYPE usStackDepth;
+    void * pvParameters;
+    StackType_t * puxStackBuffer;
+    StaticTask_t * pxTaskBuffer;
+    TaskHandle_t * pxCreatedTask;
+} PeriodicTaskParameters_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
  * in the system. */
 typedef struct xTASK_STATUS
@@ -164,6 +182,64 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with vTaskGetRunTimeWindow() to return the share of one window a task
+ * ran for. */
+typedef struct xTASK_RUN_TIME_WINDOW
+{
+    configRUN_TIME_COUNTER_TYPE ulRunTime;      /* Time the task ran during the last complete window, in run time counter units. */
+    configRUN_TIME_COUNTER_TYPE ulWindowLength; /* Length of that window in run time counter units, 0 until the first window completes. */
+    UBaseType_t uxWindowNumber;                 /* Number of windows completed so far, changes when the values above do. */
+    uint16_t usUtilisation;                     /* ulRunTime as a fraction of ulWindowLength, in units of 1 / tskUTILISATION_SCALE. */
+} TaskRunTimeWindow_t;
+
+/* Used with vTaskGetStackReport() to return how much of its stack a task has
+ * used, in words. */
+typedef struct xTASK_STACK_REPORT
+{
+    configSTACK_DEPTH_TYPE uxStackDepth;       /* Size of the stack the task was created with. */
+    configSTACK_DEPTH_TYPE uxStackUsed;        /* Deepest use seen, 0 until xTaskStackWatermarkStep() completes its first pass. */
+    configSTACK_DEPTH_TYPE uxRecommendedDepth; /* uxStackUsed with the configSTACK_WATERMARK_MARGIN_ margins added, rounded up to the stack alignment. */
+} TaskStackReport_t;
+
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+
+/* Used with vTaskGetCpuAccounting() to return the time, in run time counter
+ * units, that was not charged to any task. */
+    typedef struct xTASK_CPU_ACCOUNTING
+    {
+        configRUN_TIME_COUNTER_TYPE ulISRTime[ configACCOUNTING_ISRS ]; /* Time spent in each interrupt between traceISR_ENTER() and traceISR_EXIT(), less the time in vTaskSwitchContext(). */
+        configRUN_TIME_COUNTER_TYPE ulSchedulerTime;                    /* Time spent choosing the next task in vTaskSwitchContext(). */
+        configRUN_TIME_COUNTER_TYPE ulSwitchTime;                       /* Rest of vTaskSwitchContext(): the switched in and out hooks, stack check and per task state. */
+        configRUN_TIME_COUNTER_TYPE ulTotalTime;                        /* Time since the scheduler started, what is not above went to the tasks. */
+        UBaseType_t uxContextSwitches;                                  /* Times vTaskSwitchContext() switched to a different task. */
+    } TaskCpuAccounting_t;
+
+#endif
+
+/* Histograms kept per task by vTaskGetJobStats(), all of them in
+ * configJOB_STATS_TIMESTAMP() units. */
+typedef enum
+{
+    eJobResponseTime = 0, /* Completion time less release time. */
+    eJobLateness,         /* Completion time less absolute deadline, 0 for jobs that met their deadline. */
+    eJobStartJitter,      /* Difference between the start latency (first switch in less release time) of a job and that of the job before. */
+    eJobFinishJitter      /* Difference between the response time of a job and that of the job before. */
+} eJobHistogram;
+
+#define tskJOB_HISTOGRAMS    4
+
+/* Used with vTaskGetJobStats() to return the timing of the jobs of a periodic
+ * task.  Bucket 0 of each histogram counts values of 0, bucket n values from
+ * 2^(n-1) to 2^n - 1, and the last bucket everything above that too.  The
+ * counts stop at 0xFFFF. */
+typedef struct xTASK_JOB_STATS
+{
+    UBaseType_t uxJobs;            /* Jobs completed since the task was created or its statistics cleared. */
+    UBaseType_t uxContextSwitches; /* Times the task was switched in. */
+    UBaseType_t uxPreemptions;     /* Times the task was switched out while it was still ready to run. */
+    uint16_t usHistogram[ tskJOB_HISTOGRAMS ][ configJOB_STATS_BUCKETS ];
+} TaskJobStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -179,6 +255,23 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * Utilisation returned by vTaskGetRunTimeWindow() for a task that ran for the
+ * whole window, so the units are hundredths of a percent.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskUTILISATION_SCALE    ( 10000U )
+
+/**
+ * Evaluates to pdTRUE if the tick time xA is earlier than xB.  The times are
+ * compared modulo the tick count wrap, so they must be less than half the tick
+ * count range apart.
+ *
+ * \ingroup TaskUtils
+ */
+#define taskDEADLINE_BEFORE( xA, xB )    ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
 /**
  * task. h
  *
@@ -472,6 +565,312 @@ typedef enum
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t period );
+ * @endcode
+ *
+ * Create a periodic task and add it to the list of tasks that are ready to
+ * run.  configUSE_EDF_SCHEDULER must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * The parameters are those of xTaskCreate(), plus the release period of the
+ * task in ticks.  The first job is released when the task is created and its
+ * relative deadline is equal to the period.  The task is expected to complete
+ * each job by calling xTaskDelayUntil() with the same period, which releases
+ * the next job.
+ *
+ * uxPriority is ignored, tasks have no priority when configUSE_EDF_SCHEDULER
+ * is 1.  The position of the task in the ready list is decided by
+ * configSCHEDULING_POLICY: the absolute deadline of the current job
+ * (schedPOLICY_EDF), the period (schedPOLICY_RM), the relative deadline
+ * (schedPOLICY_DM), the laxity (schedPOLICY_LLF) or the absolute
+ * deadline until the laxity reaches zero and the laxity from then on
+ * (schedPOLICY_EDZL).
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file projdefs.h
+ *
+ * \defgroup xTaskPeriodicCreate xTaskPeriodicCreate
+ * \ingroup Tasks
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t period ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskPeriodicCreateStatic( TaskFunction_t pxTaskCode,
+ *                                         const char * const pcName,
+ *                                         const uint32_t ulStackDepth,
+ *                                         void * const pvParameters,
+ *                                         UBaseType_t uxPriority,
+ *                                         StackType_t * const puxStackBuffer,
+ *                                         StaticTask_t * const pxTaskBuffer,
+ *                                         TickType_t xPeriod );
+ * @endcode
+ *
+ * Create a periodic task without using any dynamic memory allocation.  Both
+ * configUSE_EDF_SCHEDULER and configSUPPORT_STATIC_ALLOCATION must be set to 1
+ * in FreeRTOSConfig.h for this function to be available.
+ *
+ * The task behaves exactly as one created by xTaskPeriodicCreate(), the stack
+ * and the TCB are given in the same way as for xTaskCreateStatic().
+ *
+ * @return If neither puxStackBuffer nor pxTaskBuffer are NULL, then the task
+ * will be created and a handle to the created task is returned.  If either
+ * puxStackBuffer or pxTaskBuffer are NULL then the task will not be created
+ * and NULL is returned.
+ *
+ * \defgroup xTaskPeriodicCreateStatic xTaskPeriodicCreateStatic
+ * \ingroup Tasks
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    TaskHandle_t xTaskPeriodicCreateStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            const uint32_t ulStackDepth,
+                                            void * const pvParameters,
+                                            UBaseType_t uxPriority,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer,
+                                            TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskPeriodicCreateTable( const PeriodicTaskParameters_t * const pxTaskTable,
+ *                                      UBaseType_t uxNumberOfTasks );
+ * @endcode
+ *
+ * Create every periodic task described by a task table in a single pass,
+ * without using any dynamic memory allocation.  Both configUSE_EDF_SCHEDULER
+ * and configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.  It must be called before
+ * vTaskStartScheduler().
+ *
+ * The table is normally a const array built at compile time, so the stack and
+ * the TCB of every task are placed by the linker and the memory map does not
+ * depend on the order the tasks are created in.  The first job of every task is
+ * released when the scheduler starts.
+ *
+ * @param pxTaskTable Array of task definitions.  For each entry xPeriod,
+ * xRelativeDeadline and xExecutionBudget are as for xTaskPeriodicCreate() and
+ * vTaskSetPeriodicTiming(), usStackDepth is the number of words in
+ * puxStackBuffer and pxCreatedTask, if not NULL, receives the task handle.
+ *
+ * @param uxNumberOfTasks The number of entries in pxTaskTable.
+ *
+ * @return pdPASS if every task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if an entry is missing its stack or
+ * TCB buffer.  Entries that come before such an entry are still created.
+ *
+ * Example usage:
+ * @code{c}
+ * static StackType_t xStack[ 2 ][ configMINIMAL_STACK_SIZE ];
+ * static StaticTask_t xTCB[ 2 ];
+ *
+ * static const PeriodicTaskParameters_t xTaskTable[] =
+ * {
+ *  // Function, name, period, deadline, budget, stack depth, parameters, stack, TCB, handle.
+ *  { vSensorTask,  "Sensor",  10, 8,  2, configMINIMAL_STACK_SIZE, NULL, xStack[ 0 ], &xTCB[ 0 ], NULL },
+ *  { vControlTask, "Control", 20, 20, 5, configMINIMAL_STACK_SIZE, NULL, xStack[ 1 ], &xTCB[ 1 ], NULL }
+ * };
+ *
+ * void main( void )
+ * {
+ *  xTaskPeriodicCreateTable( xTaskTable, sizeof( xTaskTable ) / sizeof( xTaskTable[ 0 ] ) );
+ *  vTaskStartScheduler();
+ * }
+ * @endcode
+ * \defgroup xTaskPeriodicCreateTable xTaskPeriodicCreateTable
+ * \ingroup Tasks
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    BaseType_t xTaskPeriodicCreateTable( const PeriodicTaskParameters_t * const pxTaskTable,
+                                         UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetPeriodicTiming( TaskHandle_t xTask,
+ *                              TickType_t xRelativeDeadline,
+ *                              TickType_t xExecutionBudget );
+ * @endcode
+ *
+ * Set the relative deadline and the execution budget of a task created with
+ * xTaskPeriodicCreate().  configUSE_EDF_SCHEDULER must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xTask Handle to the task.  Passing a NULL handle results in the
+ * timing of the calling task being set.
+ *
+ * @param xRelativeDeadline The deadline of each job, in ticks, relative to its
+ * release.  The deadline of the job in progress is moved accordingly.
+ *
+ * @param xExecutionBudget The worst case execution time of a job in ticks.  It
+ * is only used when configSCHEDULING_POLICY is schedPOLICY_LLF or
+ * schedPOLICY_EDZL, where it is needed to compute the laxity of the task.  The
+ * budget is charged one tick for every tick the task is running, and is reset
+ * when the next job is released.
+ *
+ * \defgroup vTaskSetPeriodicTiming vTaskSetPeriodicTiming
+ * \ingroup Tasks
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    void vTaskSetPeriodicTiming( TaskHandle_t xTask,
+                                 TickType_t xRelativeDeadline,
+                                 TickType_t xExecutionBudget ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULER must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xTask Handle to the task to query.  Passing a NULL handle results in
+ * the count of the calling task being returned.
+ *
+ * @return The number of jobs of the task that completed after their absolute
+ * deadline.  A job completes when the task calls xTaskDelayUntil() or
+ * vTaskDelay().
+ *
+ * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetJobStats( TaskHandle_t xTask, TaskJobStats_t * pxStats );
+ * @endcode
+ *
+ * configUSE_JOB_STATS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * The kernel takes the release time, start time, completion time and absolute
+ * deadline of every job of a periodic task, and adds the response time,
+ * lateness and start and finish jitter of the job to the histograms of the
+ * task.  A job starts the first time the task is switched in after its
+ * release, and completes when the task calls xTaskDelayUntil() or
+ * vTaskDelay().  Release times and deadlines are ticks, converted with
+ * configJOB_STATS_TICKS_TO_TIMESTAMP() from the time the last tick was
+ * processed.
+ *
+ * @param xTask Handle to the task to query.  Passing a NULL handle results in
+ * the statistics of the calling task being returned.
+ *
+ * @param pxStats Structure the statistics are copied to.
+ *
+ * \defgroup vTaskGetJobStats vTaskGetJobStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_JOB_STATS == 1 )
+    void vTaskGetJobStats( TaskHandle_t xTask,
+                           TaskJobStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskClearJobStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Clears the histograms and counts returned by vTaskGetJobStats(), for
+ * example after the timing of the task was changed with
+ * vTaskSetPeriodicTiming().  configUSE_JOB_STATS must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xTask Handle to the task.  Passing a NULL handle results in the
+ * statistics of the calling task being cleared.
+ *
+ * \defgroup vTaskClearJobStats vTaskClearJobStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_JOB_STATS == 1 )
+    void vTaskClearJobStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskRestoreDeadline( void );
+ * @endcode
+ *
+ * A task that receives from a queue created with xQueueCreateDeadlineOrdered()
+ * runs with the deadline of the message it is blocked on or serving whenever
+ * that deadline is earlier than its own, so urgent messages are handled ahead
+ * of the task's own job.  Call vTaskRestoreDeadline() once the messages have
+ * been processed to give the calling task back the deadline of its current
+ * job.  The deadline is also restored when the task completes its job by
+ * calling xTaskDelayUntil() or vTaskDelay().
+ *
+ * configUSE_DEADLINE_INHERITANCE must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * \defgroup vTaskRestoreDeadline vTaskRestoreDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+    void vTaskRestoreDeadline( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetLogicalExecution( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Puts a task created with xTaskPeriodicCreate() in logical execution time
+ * (LET) mode.  From then on the kernel latches the inputs of the task, the
+ * channels of let.h it reads, when each job is released, and commits its
+ * outputs, the channels it writes, at the absolute deadline of the job.  Other
+ * tasks, and the devices fed by commit hooks, see the outputs change at the
+ * deadline whatever the response time of the job, so the outputs have no
+ * jitter.
+ *
+ * A job that has not completed, by calling xTaskDelayUntil(), when its
+ * deadline is reached is an overrun: its outputs are not committed and those
+ * of the previous job stay in place.  If it has not completed when the next job
+ * is released either, the inputs of the next job are latched when it does.
+ *
+ * The relative deadline of the task must not be longer than its period.  Call
+ * before the scheduler is started, or from the task itself.  A task can not be
+ * taken out of LET mode.  configUSE_LOGICAL_EXECUTION_TIME must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xTask Handle to the task.  Passing a NULL handle puts the calling task
+ * in LET mode.
+ *
+ * \defgroup vTaskSetLogicalExecution vTaskSetLogicalExecution
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+    void vTaskSetLogicalExecution( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1361,7 +1760,12 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  * \defgroup vTaskSuspendAll vTaskSuspendAll
  * \ingroup SchedulerControl
  */
-void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    void vTaskSuspendAllFromSite( uint32_t ulSite ) PRIVILEGED_FUNCTION;
+    #define vTaskSuspendAll()    vTaskSuspendAllFromSite( criticalSITE() )
+#else
+    void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
@@ -1532,6 +1936,53 @@ TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) PRIVILEGED_FUNCTION; /
  */
 UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskStackWatermarkStep( TaskHandle_t xTask, UBaseType_t uxMaxWords );
+ * @endcode
+ *
+ * configUSE_STACK_WATERMARKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Brings the stack high water mark kept for xTask up to date, checking at most
+ * uxMaxWords words of its stack.  Unlike uxTaskGetStackHighWaterMark(), which
+ * checks every free word each time, a pass only checks the words that were
+ * free at the end of the previous pass, and is spread over as many calls as
+ * the budget needs.  It is meant to be called from the idle task hook, one task
+ * at a time, and must not be called for the same task from more than one task.
+ *
+ * @param xTask Handle of the task whose stack is checked, NULL for the calling
+ * task.
+ *
+ * @param uxMaxWords Most words checked by this call.
+ *
+ * @return pdTRUE if the pass over the stack of xTask completed, in which case
+ * the next call starts a new one, otherwise pdFALSE.
+ */
+BaseType_t xTaskStackWatermarkStep( TaskHandle_t xTask,
+                                    UBaseType_t uxMaxWords ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetStackReport( TaskHandle_t xTask, TaskStackReport_t * pxReport );
+ * @endcode
+ *
+ * configUSE_STACK_WATERMARKS must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Fills pxReport with the stack size of xTask, the deepest use the completed
+ * passes of xTaskStackWatermarkStep() saw, and the stack size recommended for
+ * it.  No stack is scanned.
+ *
+ * @param xTask Handle of the task, NULL for the calling task.
+ *
+ * @param pxReport Where the report is written.
+ */
+void vTaskGetStackReport( TaskHandle_t xTask,
+                          TaskStackReport_t * pxReport ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * @code{c}
@@ -1951,6 +2402,69 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetCpuAccounting( TaskCpuAccounting_t * pxAccounting );
+ * @endcode
+ *
+ * configUSE_CPU_ACCOUNTING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * Without it, the time an interrupt or the scheduler runs for is charged to
+ * the task it interrupted or switched to.  With it, the run time of a task
+ * stops at traceISR_ENTER() and restarts at traceISR_EXIT(), and
+ * vTaskSwitchContext() charges its own time to the scheduler, so the run
+ * time counters of the tasks, uxTaskGetSystemState() and
+ * vTaskGetRunTimeWindow() only count the time the tasks really ran.  The
+ * rest is returned here.
+ *
+ * The port saves the context of a task before the first timestamp of an
+ * interrupt can be taken, and restores it after the last, so that part of a
+ * context switch is still charged to the tasks.
+ *
+ * @param pxAccounting Structure the times are copied to.
+ *
+ * \defgroup vTaskGetCpuAccounting vTaskGetCpuAccounting
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+    void vTaskGetCpuAccounting( TaskCpuAccounting_t * pxAccounting ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetRunTimeWindow( TaskHandle_t xTask, UBaseType_t uxWindow, TaskRunTimeWindow_t * pxWindow );
+ * @endcode
+ *
+ * configRUN_TIME_WINDOWS must be greater than 0 for this function to be
+ * available.
+ *
+ * The time each task runs is charged when it is switched out, to the total
+ * returned by uxTaskGetSystemState() and to each of the configRUN_TIME_WINDOWS
+ * windows listed in configRUN_TIME_WINDOW_TICKS.  A window restarts every
+ * time its number of ticks has passed, so the value read here is the share
+ * of the last complete window, not of the time since boot.  Only counter
+ * differences are used, so the run time counter may wrap freely.
+ *
+ * Reading takes a short critical section and does not depend on the number
+ * of tasks or on how long ago the task last ran.
+ *
+ * @param xTask The task to read, NULL for the calling task.  Use
+ * xTaskGetIdleTaskHandle() to find how much of the window was spare.
+ *
+ * @param uxWindow Index of the window in configRUN_TIME_WINDOW_TICKS.
+ *
+ * @param pxWindow Filled with the run time of the task in the window.
+ *
+ * \defgroup vTaskGetRunTimeWindow vTaskGetRunTimeWindow
+ * \ingroup TaskUtils
+ */
+void vTaskGetRunTimeWindow( TaskHandle_t xTask,
+                            UBaseType_t uxWindow,
+                            TaskRunTimeWindow_t * pxWindow ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -3007,6 +3521,18 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  */
 portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * THESE FUNCTIONS MUST NOT BE CALLED DIRECTLY.  THEY ARE WHAT traceISR_ENTER()
+ * AND traceISR_EXIT() EXPAND TO WHEN configUSE_CPU_ACCOUNTING IS 1.
+ *
+ * Stop charging time to the running task and charge it to interrupt uxIsr
+ * instead, until the interrupt exits.  Interrupts must not nest.
+ */
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+    void vTaskAccountingISREnter( UBaseType_t uxIsr ) PRIVILEGED_FUNCTION;
+    void vTaskAccountingISRExit( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
  * THE EVENT BITS MODULE.
@@ -3042,6 +3568,18 @@ BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_F
  */
 BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
+/*
+ * Moves the deadline of xTask to xDeadline should that be earlier, until the
+ * task calls vTaskRestoreDeadline() or releases its next job.  Used by the
+ * queue implementation when a message is sent to a task blocked on a deadline
+ * ordered queue, or received from one.  Must be called from a critical section
+ * or with interrupts masked.
+ */
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+    void vTaskDeadlineInherit( TaskHandle_t const xTask,
+                               TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * If a higher priority task attempting to obtain a mutex caused a lower
  * priority task to inherit the higher priority task's priority - but the higher
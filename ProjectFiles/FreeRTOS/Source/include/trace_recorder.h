@@ -0,0 +1,297 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Kernel trace recorder.
+ *
+ * With configUSE_TRACE_RECORDER set to 1 the kernel trace macros write one
+ * fixed size record per scheduling event into a ring buffer in RAM: context
+ * switches, job releases, tasks becoming ready, tasks blocking on a delay or
+ * on an object, deadline changes, deadline misses and LET overruns.  Each
+ * record is stamped with configTRACE_RECORDER_TIMESTAMP(), which should be a
+ * free running counter much faster than the tick.
+ *
+ * Recording an event masks interrupts for a few loads and stores and never
+ * loops, so its cost is the same whatever is in the buffer.  In snapshot mode
+ * the buffer keeps the latest events until vTraceStop() is called.  In trigger
+ * mode recording stops by itself configTRACE_RECORDER_POST_TRIGGER events
+ * after the first deadline miss, so the buffer holds what led to the miss and
+ * what followed it.  Once stopped, the application reads the events out with
+ * uxTraceGetEvents() and may start again.
+ *
+ * This header is included by FreeRTOS.h before the trace macros are defaulted,
+ * and only defines those the application left undefined.  An application that
+ * defines traceTASK_SWITCHED_IN() or traceTASK_SWITCHED_OUT() itself should
+ * call traceRECORDER_TASK_SWITCHED_IN() or traceRECORDER_TASK_SWITCHED_OUT()
+ * from its definition, which expand to nothing when the recorder is disabled.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#if ( configUSE_TRACE_FACILITY != 1 )
+    #error configUSE_TRACE_RECORDER needs configUSE_TRACE_FACILITY set to 1, tasks are identified by their TCB number
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error configUSE_TRACE_RECORDER needs INCLUDE_xTaskGetCurrentTaskHandle set to 1
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP
+    #error configTRACE_RECORDER_TIMESTAMP() must be defined in FreeRTOSConfig.h to read a free running counter
+#endif
+
+/* Number of records kept, must be a power of 2. */
+#ifndef configTRACE_RECORDER_BUFFER_LENGTH
+    #define configTRACE_RECORDER_BUFFER_LENGTH    256
+#endif
+
+#if ( ( configTRACE_RECORDER_BUFFER_LENGTH & ( configTRACE_RECORDER_BUFFER_LENGTH - 1 ) ) != 0 )
+    #error configTRACE_RECORDER_BUFFER_LENGTH must be a power of 2
+#endif
+
+/* Number of records kept after the deadline miss that stops a trigger mode
+ * recording, the rest of the buffer holds the records before it. */
+#ifndef configTRACE_RECORDER_POST_TRIGGER
+    #define configTRACE_RECORDER_POST_TRIGGER    ( configTRACE_RECORDER_BUFFER_LENGTH / 4 )
+#endif
+
+#if ( configTRACE_RECORDER_POST_TRIGGER >= configTRACE_RECORDER_BUFFER_LENGTH )
+    #error configTRACE_RECORDER_POST_TRIGGER must be less than configTRACE_RECORDER_BUFFER_LENGTH
+#endif
+
+/* Events are recorded from tasks and from interrupts, with or without the
+ * scheduler suspended, so the recorder needs a mask that works in all of
+ * those.  Ports whose portSET_INTERRUPT_MASK_FROM_ISR() does nothing, because
+ * their interrupts do not nest, must define these to disable interrupts and
+ * restore the previous state. */
+#ifndef configTRACE_RECORDER_MASK_INTERRUPTS
+    #define configTRACE_RECORDER_MASK_INTERRUPTS()               portSET_INTERRUPT_MASK_FROM_ISR()
+#endif
+
+#ifndef configTRACE_RECORDER_UNMASK_INTERRUPTS
+    #define configTRACE_RECORDER_UNMASK_INTERRUPTS( uxStatus )    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxStatus )
+#endif
+
+/* Values of ucEvent.  usParam holds the low 16 bits of the value given. */
+#define recorderEVENT_SWITCH_IN        ( ( uint8_t ) 0U ) /*< The task started running. */
+#define recorderEVENT_SWITCH_OUT       ( ( uint8_t ) 1U ) /*< The task stopped running. */
+#define recorderEVENT_RELEASE          ( ( uint8_t ) 2U ) /*< A job of the task was released, usParam is the tick count. */
+#define recorderEVENT_READY            ( ( uint8_t ) 3U ) /*< The task was moved to a ready list. */
+#define recorderEVENT_BLOCK_DELAY      ( ( uint8_t ) 4U ) /*< The task blocked until the tick count in usParam. */
+#define recorderEVENT_BLOCK_OBJECT     ( ( uint8_t ) 5U ) /*< The task blocked on the queue or stream buffer at the address in usParam, 0 for a notification. */
+#define recorderEVENT_DEADLINE         ( ( uint8_t ) 6U ) /*< The absolute deadline of the task became usParam. */
+#define recorderEVENT_DEADLINE_MISS    ( ( uint8_t ) 7U ) /*< A job of the task completed after its deadline, in usParam. */
+#define recorderEVENT_LET_OVERRUN      ( ( uint8_t ) 8U ) /*< A LET job of the task was still running at its deadline. */
+
+/*
+ * One record, eight bytes.  ucTask is the TCB number of the task, the order
+ * in which tasks were created counting from 1, or 0 when no task is running.
+ */
+typedef struct xTRACE_EVENT
+{
+    uint32_t ulTimestamp; /*< configTRACE_RECORDER_TIMESTAMP() when the event was recorded. */
+    uint8_t ucEvent;      /*< One of the recorderEVENT_ values. */
+    uint8_t ucTask;       /*< Task the event is about. */
+    uint16_t usParam;     /*< Depends on ucEvent. */
+} TraceEvent_t;
+
+typedef enum
+{
+    eTraceSnapshot = 0,  /* Keep the latest events until vTraceStop() is called. */
+    eTraceTriggerOnMiss  /* Stop by itself after the first deadline miss. */
+} TraceMode_t;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * void vTraceStart( TraceMode_t eMode );
+ * void vTraceStop( void );
+ * BaseType_t xTraceIsStopped( void );
+ * @endcode
+ *
+ * vTraceStart() empties the buffer and starts recording in eMode.  Nothing is
+ * recorded before the first call.  vTraceStop() freezes the buffer, and
+ * xTraceIsStopped() returns pdTRUE once it is frozen, whether by vTraceStop()
+ * or by a deadline miss in eTraceTriggerOnMiss mode.
+ */
+void vTraceStart( TraceMode_t eMode ) PRIVILEGED_FUNCTION;
+void vTraceStop( void ) PRIVILEGED_FUNCTION;
+BaseType_t xTraceIsStopped( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ * @code{c}
+ * UBaseType_t uxTraceGetEventCount( void );
+ * UBaseType_t uxTraceGetEvents( TraceEvent_t * pxBuffer, UBaseType_t uxFirst, UBaseType_t uxMaxEvents );
+ * @endcode
+ *
+ * Read a stopped recording, oldest event first.  uxTraceGetEventCount()
+ * returns the number of events held, and uxTraceGetEvents() copies up to
+ * uxMaxEvents of them to pxBuffer starting from the uxFirst oldest, and returns
+ * the number copied.  Both return 0 while the recorder is running.
+ */
+UBaseType_t uxTraceGetEventCount( void ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTraceGetEvents( TraceEvent_t * pxBuffer,
+                              UBaseType_t uxFirst,
+                              UBaseType_t uxMaxEvents ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the trace macros below.  vTraceRecordCurrent() records an event
+ * about the running task, for the macros expanded outside tasks.c.
+ */
+void vTraceRecord( uint8_t ucEvent,
+                   UBaseType_t uxTask,
+                   uint32_t ulParam ) PRIVILEGED_FUNCTION;
+void vTraceRecordCurrent( uint8_t ucEvent,
+                          uint32_t ulParam ) PRIVILEGED_FUNCTION;
+
+#define recorderOBJECT( pvObject )    ( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) ( pvObject ) )
+
+/* The macros taking a TCB are only expanded in tasks.c. */
+#define traceRECORDER_TASK_SWITCHED_IN()     vTraceRecord( recorderEVENT_SWITCH_IN, pxCurrentTCB->uxTCBNumber, 0U )
+#define traceRECORDER_TASK_SWITCHED_OUT()    vTraceRecord( recorderEVENT_SWITCH_OUT, pxCurrentTCB->uxTCBNumber, 0U )
+
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()    traceRECORDER_TASK_SWITCHED_IN()
+#endif
+
+#ifndef traceTASK_SWITCHED_OUT
+    #define traceTASK_SWITCHED_OUT()    traceRECORDER_TASK_SWITCHED_OUT()
+#endif
+
+/* The TCB number is copied to the task number so vTraceRecordCurrent() can
+ * find it through the public API.  A periodic task has its first job released
+ * when it is created. */
+#ifndef traceTASK_CREATE
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        #define traceTASK_CREATE( pxNewTCB )                                                                        \
+    do {                                                                                                            \
+        ( pxNewTCB )->uxTaskNumber = ( pxNewTCB )->uxTCBNumber;                                                     \
+                                                                                                                    \
+        if( ( pxNewTCB )->xTaskPeriod != taskNON_PERIODIC )                                                         \
+        {                                                                                                           \
+            vTraceRecord( recorderEVENT_RELEASE, ( pxNewTCB )->uxTCBNumber, ( uint32_t ) xTickCount );              \
+            vTraceRecord( recorderEVENT_DEADLINE, ( pxNewTCB )->uxTCBNumber, ( uint32_t ) ( pxNewTCB )->xTaskDeadline ); \
+        }                                                                                                           \
+    } while( 0 )
+    #else
+        #define traceTASK_CREATE( pxNewTCB )    ( pxNewTCB )->uxTaskNumber = ( pxNewTCB )->uxTCBNumber
+    #endif
+#endif
+
+#ifndef traceTASK_RELEASE
+    #define traceTASK_RELEASE( pxTCB )    vTraceRecord( recorderEVENT_RELEASE, ( pxTCB )->uxTCBNumber, ( uint32_t ) xTickCount )
+#endif
+
+#ifndef traceMOVED_TASK_TO_READY_STATE
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceRecord( recorderEVENT_READY, ( pxTCB )->uxTCBNumber, 0U )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+    #define traceTASK_DELAY_UNTIL( xTimeToWake )    vTraceRecord( recorderEVENT_BLOCK_DELAY, pxCurrentTCB->uxTCBNumber, ( uint32_t ) ( xTimeToWake ) )
+#endif
+
+#ifndef traceTASK_DELAY
+    #define traceTASK_DELAY()    vTraceRecord( recorderEVENT_BLOCK_DELAY, pxCurrentTCB->uxTCBNumber, ( uint32_t ) ( xTickCount + xTicksToDelay ) )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    vTraceRecordCurrent( recorderEVENT_BLOCK_OBJECT, recorderOBJECT( pxQueue ) )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_PEEK
+    #define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )    vTraceRecordCurrent( recorderEVENT_BLOCK_OBJECT, recorderOBJECT( pxQueue ) )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    vTraceRecordCurrent( recorderEVENT_BLOCK_OBJECT, recorderOBJECT( pxQueue ) )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+    #define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )    vTraceRecordCurrent( recorderEVENT_BLOCK_OBJECT, recorderOBJECT( xStreamBuffer ) )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+    #define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )    vTraceRecordCurrent( recorderEVENT_BLOCK_OBJECT, recorderOBJECT( xStreamBuffer ) )
+#endif
+
+#ifndef traceTASK_NOTIFY_TAKE_BLOCK
+    #define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )    vTraceRecord( recorderEVENT_BLOCK_OBJECT, pxCurrentTCB->uxTCBNumber, 0U )
+#endif
+
+#ifndef traceTASK_NOTIFY_WAIT_BLOCK
+    #define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )    vTraceRecord( recorderEVENT_BLOCK_OBJECT, pxCurrentTCB->uxTCBNumber, 0U )
+#endif
+
+#ifndef traceTASK_DEADLINE_SET
+    #define traceTASK_DEADLINE_SET( pxTCB )    vTraceRecord( recorderEVENT_DEADLINE, ( pxTCB )->uxTCBNumber, ( uint32_t ) ( pxTCB )->xTaskDeadline )
+#endif
+
+#ifndef traceTASK_DEADLINE_INHERIT
+    #define traceTASK_DEADLINE_INHERIT( pxTCB, xInheritedDeadline )    vTraceRecord( recorderEVENT_DEADLINE, ( pxTCB )->uxTCBNumber, ( uint32_t ) ( xInheritedDeadline ) )
+#endif
+
+#ifndef traceTASK_DEADLINE_RESTORE
+    #define traceTASK_DEADLINE_RESTORE( pxTCB )    vTraceRecord( recorderEVENT_DEADLINE, ( pxTCB )->uxTCBNumber, ( uint32_t ) ( pxTCB )->xTaskBaseDeadline )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )    vTraceRecord( recorderEVENT_DEADLINE_MISS, ( pxTCB )->uxTCBNumber, ( uint32_t ) ( pxTCB )->xTaskDeadline )
+#endif
+
+#ifndef traceTASK_LET_OVERRUN
+    #define traceTASK_LET_OVERRUN( pxTCB )    vTraceRecord( recorderEVENT_LET_OVERRUN, ( pxTCB )->uxTCBNumber, 0U )
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#else /* configUSE_TRACE_RECORDER */
+
+#define traceRECORDER_TASK_SWITCHED_IN()
+#define traceRECORDER_TASK_SWITCHED_OUT()
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#endif /* TRACE_RECORDER_H */
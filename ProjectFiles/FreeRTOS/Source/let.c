@@ -0,0 +1,167 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_LET
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "let.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+
+#define letSLOT( pxChannel, ucSlot )    ( ( pxChannel )->pucStorage + ( ( UBaseType_t ) ( ucSlot ) * ( pxChannel )->uxItemSize ) )
+
+/* The slot indexes are always 0, 1 and 2, so the one that is neither of two
+ * different slots is found without a search. */
+#define letOTHER_SLOT( ucSlotA, ucSlotB )    ( ( uint8_t ) ( 3U - ( ucSlotA ) - ( ucSlotB ) ) )
+
+/* Every initialised channel, walked by the kernel at each LET instant. */
+PRIVILEGED_DATA static LetChannel_t * pxChannels = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vLetChannelInitialise( LetChannel_t * pxChannel,
+                            void * pvStorage,
+                            UBaseType_t uxItemSize,
+                            TaskHandle_t xWriter,
+                            TaskHandle_t xReader,
+                            LetCommitHook_t pxCommitHook )
+{
+    configASSERT( pxChannel );
+    configASSERT( pvStorage );
+    configASSERT( xWriter );
+    configASSERT( ( xReader == NULL ) != ( pxCommitHook == NULL ) );
+
+    pxChannel->pucStorage = ( uint8_t * ) pvStorage;
+    pxChannel->uxItemSize = uxItemSize;
+    pxChannel->xWriter = xWriter;
+    pxChannel->xReader = xReader;
+    pxChannel->pxCommitHook = pxCommitHook;
+    pxChannel->ucCommitted = 0U;
+    pxChannel->ucLatched = 0U;
+    pxChannel->ucWriting = 1U;
+
+    ( void ) memcpy( ( void * ) letSLOT( pxChannel, 1U ), pvStorage, ( size_t ) uxItemSize );
+    ( void ) memcpy( ( void * ) letSLOT( pxChannel, 2U ), pvStorage, ( size_t ) uxItemSize );
+
+    taskENTER_CRITICAL();
+    {
+        pxChannel->pxNext = pxChannels;
+        pxChannels = pxChannel;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void * pvLetChannelWriteBuffer( LetChannel_t * pxChannel )
+{
+    configASSERT( pxChannel );
+
+    return ( void * ) letSLOT( pxChannel, pxChannel->ucWriting );
+}
+/*-----------------------------------------------------------*/
+
+const void * pvLetChannelReadBuffer( const LetChannel_t * pxChannel )
+{
+    configASSERT( pxChannel );
+
+    return ( const void * ) letSLOT( pxChannel, pxChannel->ucLatched );
+}
+/*-----------------------------------------------------------*/
+
+void vLetCommitOutputs( TaskHandle_t xTask )
+{
+    LetChannel_t * pxChannel;
+    uint8_t ucPrevious;
+
+    for( pxChannel = pxChannels; pxChannel != NULL; pxChannel = pxChannel->pxNext )
+    {
+        if( pxChannel->xWriter == xTask )
+        {
+            ucPrevious = pxChannel->ucCommitted;
+            pxChannel->ucCommitted = pxChannel->ucWriting;
+
+            if( pxChannel->pxCommitHook != NULL )
+            {
+                /* The hook owns the committed slot until the next commit, and
+                 * is done with the one before. */
+                pxChannel->ucLatched = pxChannel->ucCommitted;
+                pxChannel->ucWriting = letOTHER_SLOT( pxChannel->ucCommitted, ucPrevious );
+                pxChannel->pxCommitHook( ( void * ) letSLOT( pxChannel, pxChannel->ucCommitted ) );
+            }
+            else
+            {
+                /* The slot just written was never latched, so it differs from
+                 * the one the reader holds. */
+                pxChannel->ucWriting = letOTHER_SLOT( pxChannel->ucCommitted, pxChannel->ucLatched );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vLetLatchInputs( TaskHandle_t xTask )
+{
+    LetChannel_t * pxChannel;
+
+    for( pxChannel = pxChannels; pxChannel != NULL; pxChannel = pxChannel->pxNext )
+    {
+        if( pxChannel->xReader == xTask )
+        {
+            /* The writer never fills the committed slot, so after this it
+             * still fills neither the latched nor the committed one. */
+            pxChannel->ucLatched = pxChannel->ucCommitted;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+
+#endif /* configUSE_LOGICAL_EXECUTION_TIME */
@@ -0,0 +1,317 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_MEMPOOL
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mempool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* The pools the kernel takes its objects from. */
+#if ( configMEMPOOL_TCB_COUNT > 0 )
+    mempoolDEFINE( xMemPoolTCB, "TCB", sizeof( StaticTask_t ), configMEMPOOL_TCB_COUNT );
+#endif
+
+#if ( configMEMPOOL_QUEUE_COUNT > 0 )
+    mempoolDEFINE( xMemPoolQueue, "Queue", configMEMPOOL_QUEUE_BLOCK_SIZE, configMEMPOOL_QUEUE_COUNT );
+#endif
+
+/*
+ * Take a block from / return a block to a pool.  Must be called with
+ * interrupts masked.
+ */
+static void * prvAllocBlock( MemPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+static void prvFreeBlock( MemPool_t * const pxPool,
+                          void * pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+void vMemPoolInitialise( MemPool_t * pxPool,
+                         const char * pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                         void * pvStorage,
+                         size_t xObjectSize,
+                         UBaseType_t uxBlockCount )
+{
+    configASSERT( pxPool );
+    configASSERT( pvStorage );
+    configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pvStorage ) & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+    pxPool->pcName = pcName;
+    pxPool->pucStorage = ( uint8_t * ) pvStorage;
+    pxPool->xBlockSize = mempoolBLOCK_SIZE( xObjectSize );
+    pxPool->uxBlockCount = uxBlockCount;
+    pxPool->uxNeverUsedBlocks = uxBlockCount;
+    pxPool->pvFreeList = NULL;
+    pxPool->uxFreeBlocks = uxBlockCount;
+    pxPool->uxMinimumEverFreeBlocks = uxBlockCount;
+    pxPool->uxNumberOfAllocations = 0;
+    pxPool->uxNumberOfFailedAllocations = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocBlock( MemPool_t * const pxPool )
+{
+    void * pvBlock;
+
+    if( pxPool->pvFreeList != NULL )
+    {
+        /* Reuse the block freed last, it is the most likely to be in cache. */
+        pvBlock = pxPool->pvFreeList;
+        pxPool->pvFreeList = *( ( void ** ) pvBlock );
+    }
+    else if( pxPool->uxNeverUsedBlocks > ( UBaseType_t ) 0 )
+    {
+        pxPool->uxNeverUsedBlocks--;
+        pvBlock = ( void * ) &( pxPool->pucStorage[ ( pxPool->uxBlockCount - pxPool->uxNeverUsedBlocks - ( UBaseType_t ) 1 ) * pxPool->xBlockSize ] );
+    }
+    else
+    {
+        pvBlock = NULL;
+    }
+
+    if( pvBlock != NULL )
+    {
+        pxPool->uxFreeBlocks--;
+        pxPool->uxNumberOfAllocations++;
+
+        if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+        {
+            pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        pxPool->uxNumberOfFailedAllocations++;
+    }
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlock( MemPool_t * const pxPool,
+                          void * pvBlock )
+{
+    configASSERT( xMemPoolContains( pxPool, pvBlock ) != pdFALSE );
+    configASSERT( pxPool->uxFreeBlocks < pxPool->uxBlockCount );
+
+    *( ( void ** ) pvBlock ) = pxPool->pvFreeList;
+    pxPool->pvFreeList = pvBlock;
+    pxPool->uxFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAlloc( MemPoolHandle_t xPool )
+{
+    void * pvBlock;
+
+    configASSERT( xPool );
+
+    taskENTER_CRITICAL();
+    {
+        pvBlock = prvAllocBlock( xPool );
+    }
+    taskEXIT_CRITICAL();
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAllocFromISR( MemPoolHandle_t xPool )
+{
+    void * pvBlock;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( xPool );
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        pvBlock = prvAllocBlock( xPool );
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( MemPoolHandle_t xPool,
+                   void * pvBlock )
+{
+    configASSERT( xPool );
+
+    if( pvBlock != NULL )
+    {
+        taskENTER_CRITICAL();
+        {
+            prvFreeBlock( xPool, pvBlock );
+        }
+        taskEXIT_CRITICAL();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( MemPoolHandle_t xPool,
+                          void * pvBlock )
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( xPool );
+
+    if( pvBlock != NULL )
+    {
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvFreeBlock( xPool, pvBlock );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMemPoolContains( MemPoolHandle_t xPool,
+                             const void * pvBlock )
+{
+    const uint8_t * pucBlock = ( const uint8_t * ) pvBlock;
+    BaseType_t xReturn;
+
+    if( ( pucBlock >= xPool->pucStorage ) &&
+        ( pucBlock < &( xPool->pucStorage[ xPool->uxBlockCount * xPool->xBlockSize ] ) ) )
+    {
+        /* Must also be the start of a block. */
+        configASSERT( ( ( size_t ) ( pucBlock - xPool->pucStorage ) % xPool->xBlockSize ) == 0 );
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolGetStats( MemPoolHandle_t xPool,
+                       MemPoolStats_t * pxStats )
+{
+    configASSERT( xPool );
+    configASSERT( pxStats );
+
+    taskENTER_CRITICAL();
+    {
+        pxStats->pcName = xPool->pcName;
+        pxStats->xBlockSize = xPool->xBlockSize;
+        pxStats->uxBlockCount = xPool->uxBlockCount;
+        pxStats->uxFreeBlocks = xPool->uxFreeBlocks;
+        pxStats->uxMinimumEverFreeBlocks = xPool->uxMinimumEverFreeBlocks;
+        pxStats->uxNumberOfAllocations = xPool->uxNumberOfAllocations;
+        pxStats->uxNumberOfFailedAllocations = xPool->uxNumberOfFailedAllocations;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void * pvMemPoolAllocWithFallback( MemPoolHandle_t xPool,
+                                   size_t xSize,
+                                   UBaseType_t uxCategory )
+{
+    void * pvBlock = NULL;
+
+    if( xSize <= xPool->xBlockSize )
+    {
+        pvBlock = pvMemPoolAlloc( xPool );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            if( pvBlock == NULL )
+            {
+                pvBlock = pvPortMallocCategory( xSize, uxCategory );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else
+        {
+            ( void ) uxCategory;
+        }
+    #endif
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeWithFallback( MemPoolHandle_t xPool,
+                               void * pvBlock )
+{
+    if( xMemPoolContains( xPool, pvBlock ) != pdFALSE )
+    {
+        vMemPoolFree( xPool, pvBlock );
+    }
+    else
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( pvBlock );
+            }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
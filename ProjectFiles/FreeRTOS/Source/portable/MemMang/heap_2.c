@@ -42,6 +42,9 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_HEAP
+
 #include "FreeRTOS.h"
 #include "task.h"
 
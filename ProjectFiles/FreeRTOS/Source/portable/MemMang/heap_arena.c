@@ -0,0 +1,290 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An arena implementation of pvPortMalloc() for systems that create all their
+ * kernel objects once, at start up, and never delete them.
+ *
+ * Memory is handed out by moving a pointer through the heap array, so there
+ * is no block header and the only overhead is the padding needed to keep each
+ * allocation aligned.  Memory is never returned to the heap - vPortFree() only
+ * accepts NULL.
+ *
+ * Once vPortHeapLock() has been called, or once the scheduler has started if
+ * configARENA_LOCK_AFTER_SCHEDULER_START is 1, any further allocation fails
+ * the configASSERT() and returns NULL, so memory use is fixed by the time the
+ * application is running.
+ *
+ * When configUSE_HEAP_CATEGORIES is 1 the bytes taken by TCBs, stacks, queues
+ * and everything else are counted separately, see
+ * xPortGetHeapCategoryUsage().
+ *
+ * See heap_1.c for the original implementation of this scheme, and the memory
+ * management pages of https://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_HEAP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configARENA_LOCK_AFTER_SCHEDULER_START
+    #define configARENA_LOCK_AFTER_SCHEDULER_START    0
+#endif
+
+#if ( ( configARENA_LOCK_AFTER_SCHEDULER_START == 1 ) && ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 ) )
+    #error INCLUDE_xTaskGetSchedulerState must be 1 when configARENA_LOCK_AFTER_SCHEDULER_START is 1
+#endif
+
+/* A few bytes might be lost to byte aligning the heap start address. */
+#define configADJUSTED_HEAP_SIZE    ( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Index into the heap array of the next free byte. */
+static size_t xNextFreeByte = ( size_t ) 0;
+
+/* Set once the heap must not hand out any more memory. */
+static BaseType_t xHeapLocked = pdFALSE;
+
+static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0;
+
+#if ( configUSE_HEAP_CATEGORIES == 1 )
+    static size_t xCategoryUsage[ portHEAP_CATEGORY_COUNT ] = { 0 };
+#endif
+
+/*
+ * Shared by pvPortMalloc() and pvPortMallocCategory().
+ */
+static void * prvArenaMalloc( size_t xWantedSize,
+                              UBaseType_t uxCategory );
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvArenaMalloc( xWantedSize, portHEAP_CATEGORY_OTHER );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_CATEGORIES == 1 )
+
+    void * pvPortMallocCategory( size_t xWantedSize,
+                                 UBaseType_t uxCategory )
+    {
+        return prvArenaMalloc( xWantedSize, uxCategory );
+    }
+
+#endif /* configUSE_HEAP_CATEGORIES */
+/*-----------------------------------------------------------*/
+
+static void * prvArenaMalloc( size_t xWantedSize,
+                              UBaseType_t uxCategory )
+{
+    void * pvReturn = NULL;
+    static uint8_t * pucAlignedHeap = NULL;
+
+    configASSERT( uxCategory < ( UBaseType_t ) portHEAP_CATEGORY_COUNT );
+
+    /* Ensure that blocks are always aligned. */
+    #if ( portBYTE_ALIGNMENT != 1 )
+        {
+            if( xWantedSize & portBYTE_ALIGNMENT_MASK )
+            {
+                /* Byte alignment required. Check for overflow. */
+                if( ( xWantedSize + ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) ) ) > xWantedSize )
+                {
+                    xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+                }
+                else
+                {
+                    xWantedSize = 0;
+                }
+            }
+        }
+    #endif /* if ( portBYTE_ALIGNMENT != 1 ) */
+
+    vTaskSuspendAll();
+    {
+        #if ( configARENA_LOCK_AFTER_SCHEDULER_START == 1 )
+            {
+                if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+                {
+                    xHeapLocked = pdTRUE;
+                }
+            }
+        #endif
+
+        /* Everything should have been allocated before the heap was locked. */
+        configASSERT( xHeapLocked == pdFALSE );
+
+        if( pucAlignedHeap == NULL )
+        {
+            /* Ensure the heap starts on a correctly aligned boundary. */
+            pucAlignedHeap = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) & ucHeap[ portBYTE_ALIGNMENT - 1 ] ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+        }
+
+        /* Check there is enough room left for the allocation. */
+        if( ( xHeapLocked == pdFALSE ) &&
+            ( xWantedSize > 0 ) &&                                         /* valid size */
+            ( ( xNextFreeByte + xWantedSize ) < configADJUSTED_HEAP_SIZE ) &&
+            ( ( xNextFreeByte + xWantedSize ) > xNextFreeByte ) )          /* Check for overflow. */
+        {
+            /* Return the next free byte then increment the index past this
+             * block. */
+            pvReturn = pucAlignedHeap + xNextFreeByte;
+            xNextFreeByte += xWantedSize;
+            xNumberOfSuccessfulAllocations++;
+
+            #if ( configUSE_HEAP_CATEGORIES == 1 )
+                {
+                    xCategoryUsage[ uxCategory ] += xWantedSize;
+                }
+            #else
+                {
+                    ( void ) uxCategory;
+                }
+            #endif
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                extern void vApplicationMallocFailedHook( void );
+                vApplicationMallocFailedHook();
+            }
+        }
+    #endif
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    /* Memory cannot be freed using this scheme.  See heap_2.c, heap_3.c and
+     * heap_tlsf.c for alternative implementations, and the memory management
+     * pages of https://www.FreeRTOS.org for more information. */
+    ( void ) pv;
+
+    /* Force an assert as it is invalid to call this function. */
+    configASSERT( pv == NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortHeapLock( void )
+{
+    vTaskSuspendAll();
+    {
+        xHeapLocked = pdTRUE;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* Only required when static memory is not cleared. */
+    xNextFreeByte = ( size_t ) 0;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return( configADJUSTED_HEAP_SIZE - xNextFreeByte );
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    /* Nothing is ever freed, so the heap has never had more free space than it
+     * has now. */
+    return xPortGetFreeHeapSize();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    vTaskSuspendAll();
+    {
+        /* The free space is always a single block at the end of the heap. */
+        pxHeapStats->xAvailableHeapSpaceInBytes = xPortGetFreeHeapSize();
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xNumberOfFreeBlocks = ( pxHeapStats->xAvailableHeapSpaceInBytes > 0 ) ? 1 : 0;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = pxHeapStats->xAvailableHeapSpaceInBytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = 0;
+        pxHeapStats->xFragmentationPercent = 0;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_CATEGORIES == 1 )
+
+    size_t xPortGetHeapCategoryUsage( UBaseType_t uxCategory )
+    {
+        size_t xReturn = 0;
+
+        if( uxCategory < ( UBaseType_t ) portHEAP_CATEGORY_COUNT )
+        {
+            xReturn = xCategoryUsage[ uxCategory ];
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HEAP_CATEGORIES */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,599 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A two level segregated fit (TLSF) implementation of pvPortMalloc() and
+ * vPortFree().  Free blocks are kept in an array of lists indexed by size
+ * class, with a bitmap recording which lists are not empty, so both
+ * allocating and freeing take a bounded number of steps whatever the number
+ * and layout of the free blocks.  Adjacent free blocks are combined when a
+ * block is freed.
+ *
+ * The first level splits block sizes by power of two, the second level splits
+ * each power of two range into 2 ^ configTLSF_SL_INDEX_COUNT_LOG2 linear
+ * ranges.  A request is rounded up to the next second level range before the
+ * search, so any block found in a non-empty list is large enough - good fit
+ * rather than best fit.
+ *
+ * See heap_2.c for a best fit implementation that does not combine free
+ * blocks, and the memory management pages of https://www.FreeRTOS.org for more
+ * information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_HEAP
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Number of second level lists per first level list, as a power of two. */
+#ifndef configTLSF_SL_INDEX_COUNT_LOG2
+    #define configTLSF_SL_INDEX_COUNT_LOG2    3
+#endif
+
+/* Blocks, and so the heap, must be smaller than 2 ^ configTLSF_FL_INDEX_MAX
+ * bytes.  Each step down saves 2 ^ configTLSF_SL_INDEX_COUNT_LOG2 list
+ * pointers. */
+#ifndef configTLSF_FL_INDEX_MAX
+    #define configTLSF_FL_INDEX_MAX    16
+#endif
+
+#if ( configTLSF_SL_INDEX_COUNT_LOG2 > 5 )
+    #error configTLSF_SL_INDEX_COUNT_LOG2 must not be more than 5 as the second level bitmap is 32 bits
+#endif
+
+/* portBYTE_ALIGNMENT as a power of two. */
+#if ( portBYTE_ALIGNMENT == 32 )
+    #define heapALIGNMENT_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    3
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    2
+#elif ( portBYTE_ALIGNMENT == 2 )
+    #define heapALIGNMENT_LOG2    1
+#else
+    #define heapALIGNMENT_LOG2    0
+#endif
+
+/* Sizes below heapSMALL_BLOCK_SIZE all share the first first level list, which
+ * is split linearly into the second level lists. */
+#define heapSL_INDEX_COUNT     ( 1UL << configTLSF_SL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT     ( configTLSF_SL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT     ( configTLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE   ( ( size_t ) ( 1UL << heapFL_INDEX_SHIFT ) )
+
+/* A few bytes might be lost to byte aligning the heap start address, and one
+ * block header is used to mark the end of the heap. */
+#define configADJUSTED_HEAP_SIZE    ( configTOTAL_HEAP_SIZE - portBYTE_ALIGNMENT )
+
+/* The least significant bit of xBlockSize is set while the block is free.
+ * Block sizes are a multiple of portBYTE_ALIGNMENT so the bit is never part of
+ * the size. */
+#define heapBLOCK_FREE_BIT              ( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )       ( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )    ( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock ) \
+    ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*
+ * Initialises the heap structures before their first use.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Returns the index of the most significant set bit of a non zero value.
+ */
+static UBaseType_t prvFls( uint32_t ulValue );
+
+/*
+ * Maps a block size onto the first and second level list it is stored in.
+ */
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFL,
+                              UBaseType_t * puxSL );
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Header at the start of every block.  pxNextFreeBlock and pxPreviousFreeBlock
+ * are only valid while the block is free, and take up the start of the memory
+ * that is handed out while it is allocated. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /*<< The block that is immediately before this one in memory, NULL for the first block. */
+    size_t xBlockSize;                             /*<< The size of the block, header included, plus heapBLOCK_FREE_BIT. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /*<< The next block in the same free list. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/* Only the first two members of BlockLink_t are kept while a block is
+ * allocated. */
+static const uint16_t heapSTRUCT_SIZE = ( ( ( sizeof( BlockLink_t * ) + sizeof( size_t ) ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~portBYTE_ALIGNMENT_MASK );
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( ( sizeof( BlockLink_t ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~portBYTE_ALIGNMENT_MASK ) )
+
+/* Bit N of uxFLBitmap is set when any list in xFreeLists[ N ] is not empty,
+ * bit M of ulSLBitmap[ N ] is set when xFreeLists[ N ][ M ] is not empty. */
+static uint32_t ulFLBitmap = 0;
+static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Keeps track of the number of free bytes remaining, and the lowest it has
+ * been. */
+static size_t xFreeBytesRemaining = ( size_t ) 0U;
+static size_t xMinimumEverFreeBytesRemaining = ( size_t ) 0U;
+static size_t xNumberOfSuccessfulAllocations = ( size_t ) 0U;
+static size_t xNumberOfSuccessfulFrees = ( size_t ) 0U;
+
+/* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
+
+/*
+ * Insert a free block at the head of the list for its size.
+ */
+#define prvInsertBlockIntoFreeList( pxBlockToInsert )                                        \
+    {                                                                                        \
+        UBaseType_t uxInsertFL, uxInsertSL;                                                  \
+                                                                                             \
+        prvMappingInsert( heapBLOCK_SIZE( pxBlockToInsert ), &uxInsertFL, &uxInsertSL );     \
+        ( pxBlockToInsert )->xBlockSize |= heapBLOCK_FREE_BIT;                               \
+        ( pxBlockToInsert )->pxPreviousFreeBlock = NULL;                                     \
+        ( pxBlockToInsert )->pxNextFreeBlock = pxFreeLists[ uxInsertFL ][ uxInsertSL ];      \
+                                                                                             \
+        if( pxFreeLists[ uxInsertFL ][ uxInsertSL ] != NULL )                                \
+        {                                                                                    \
+            pxFreeLists[ uxInsertFL ][ uxInsertSL ]->pxPreviousFreeBlock = ( pxBlockToInsert ); \
+        }                                                                                    \
+                                                                                             \
+        pxFreeLists[ uxInsertFL ][ uxInsertSL ] = ( pxBlockToInsert );                       \
+        ulFLBitmap |= ( 1UL << uxInsertFL );                                                 \
+        ulSLBitmap[ uxInsertFL ] |= ( 1UL << uxInsertSL );                                   \
+    }
+
+/*
+ * Remove a free block from the list it is stored in.  The block is still
+ * marked as free.
+ */
+#define prvRemoveBlockFromFreeList( pxBlockToRemove )                                                  \
+    {                                                                                                  \
+        UBaseType_t uxRemoveFL, uxRemoveSL;                                                            \
+                                                                                                       \
+        prvMappingInsert( heapBLOCK_SIZE( pxBlockToRemove ), &uxRemoveFL, &uxRemoveSL );               \
+                                                                                                       \
+        if( ( pxBlockToRemove )->pxNextFreeBlock != NULL )                                             \
+        {                                                                                              \
+            ( pxBlockToRemove )->pxNextFreeBlock->pxPreviousFreeBlock = ( pxBlockToRemove )->pxPreviousFreeBlock; \
+        }                                                                                              \
+                                                                                                       \
+        if( ( pxBlockToRemove )->pxPreviousFreeBlock != NULL )                                         \
+        {                                                                                              \
+            ( pxBlockToRemove )->pxPreviousFreeBlock->pxNextFreeBlock = ( pxBlockToRemove )->pxNextFreeBlock; \
+        }                                                                                              \
+        else                                                                                           \
+        {                                                                                              \
+            pxFreeLists[ uxRemoveFL ][ uxRemoveSL ] = ( pxBlockToRemove )->pxNextFreeBlock;            \
+                                                                                                       \
+            if( pxFreeLists[ uxRemoveFL ][ uxRemoveSL ] == NULL )                                      \
+            {                                                                                          \
+                ulSLBitmap[ uxRemoveFL ] &= ~( 1UL << uxRemoveSL );                                    \
+                                                                                                       \
+                if( ulSLBitmap[ uxRemoveFL ] == 0UL )                                                  \
+                {                                                                                      \
+                    ulFLBitmap &= ~( 1UL << uxRemoveFL );                                              \
+                }                                                                                      \
+            }                                                                                          \
+        }                                                                                              \
+    }
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock = NULL;
+    BlockLink_t * pxNewBlockLink;
+    static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+    void * pvReturn = NULL;
+    size_t xSearchSize;
+    uint32_t ulMap;
+    UBaseType_t uxFL, uxSL;
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if( xHeapHasBeenInitialised == pdFALSE )
+        {
+            prvHeapInit();
+            xHeapHasBeenInitialised = pdTRUE;
+        }
+
+        /* The wanted size must be increased so it can contain the block header
+         * in addition to the requested amount of bytes. */
+        if( ( xWantedSize > 0 ) &&
+            ( ( xWantedSize + heapSTRUCT_SIZE ) > xWantedSize ) ) /* Overflow check */
+        {
+            xWantedSize += heapSTRUCT_SIZE;
+
+            /* Byte alignment required. Check for overflow. */
+            if( ( xWantedSize + ( portBYTE_ALIGNMENT - 1 ) ) > xWantedSize )
+            {
+                xWantedSize = ( xWantedSize + ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+                /* The block must be able to hold the free list links once it is
+                 * freed again. */
+                if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+                {
+                    xWantedSize = heapMINIMUM_BLOCK_SIZE;
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            /* Round the size up to the start of the next second level range so
+             * every block in the list that is found is large enough. */
+            xSearchSize = xWantedSize;
+
+            if( xSearchSize >= heapSMALL_BLOCK_SIZE )
+            {
+                xSearchSize += ( ( size_t ) 1 << ( prvFls( ( uint32_t ) xSearchSize ) - configTLSF_SL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+            }
+
+            prvMappingInsert( xSearchSize, &uxFL, &uxSL );
+
+            if( uxFL < ( UBaseType_t ) heapFL_INDEX_COUNT )
+            {
+                /* First look for a non-empty list in the same first level
+                 * range, then in the first non-empty larger range. */
+                ulMap = ulSLBitmap[ uxFL ] & ( ~0UL << uxSL );
+
+                if( ulMap == 0UL )
+                {
+                    ulMap = ( uxFL + 1U < 32U ) ? ( ulFLBitmap & ( ~0UL << ( uxFL + 1U ) ) ) : 0UL;
+
+                    if( ulMap != 0UL )
+                    {
+                        uxFL = prvFls( ulMap & ( ~ulMap + 1UL ) );
+                        ulMap = ulSLBitmap[ uxFL ];
+                    }
+                }
+
+                if( ulMap != 0UL )
+                {
+                    uxSL = prvFls( ulMap & ( ~ulMap + 1UL ) );
+                    pxBlock = pxFreeLists[ uxFL ][ uxSL ];
+                }
+            }
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveBlockFromFreeList( pxBlock );
+                pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+
+                /* If the block is larger than required it can be split into two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+                {
+                    /* This block is to be split into two.  Create a new block
+                     * following the number of bytes requested. The void cast is
+                     * used to prevent byte alignment warnings from the compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    prvInsertBlockIntoFreeList( pxNewBlockLink );
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+
+                xNumberOfSuccessfulAllocations++;
+
+                /* Return the memory space - jumping over the block header. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapSTRUCT_SIZE );
+            }
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                extern void vApplicationMallocFailedHook( void );
+                vApplicationMallocFailedHook();
+            }
+        }
+    #endif
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= heapSTRUCT_SIZE;
+
+        /* This unexpected casting is to keep some compilers from issuing
+         * byte alignment warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( !heapBLOCK_IS_FREE( pxLink ) );
+
+        vTaskSuspendAll();
+        {
+            xFreeBytesRemaining += pxLink->xBlockSize;
+            xNumberOfSuccessfulFrees++;
+            traceFREE( pv, pxLink->xBlockSize );
+
+            /* Combine with the block that follows, if it is free.  The end of
+             * the heap is marked by a block that is never free. */
+            pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+            if( heapBLOCK_IS_FREE( pxNeighbour ) )
+            {
+                prvRemoveBlockFromFreeList( pxNeighbour );
+                pxLink->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+            }
+
+            /* Combine with the block that comes before, if it is free. */
+            pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+
+            if( ( pxNeighbour != NULL ) && heapBLOCK_IS_FREE( pxNeighbour ) )
+            {
+                prvRemoveBlockFromFreeList( pxNeighbour );
+                pxNeighbour->xBlockSize = heapBLOCK_SIZE( pxNeighbour ) + pxLink->xBlockSize;
+                heapNEXT_PHYSICAL_BLOCK( pxNeighbour )->pxPreviousPhysicalBlock = pxNeighbour;
+                pxLink = pxNeighbour;
+            }
+
+            prvInsertBlockIntoFreeList( pxLink );
+        }
+        ( void ) xTaskResumeAll();
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFL, uxSL;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Walking the free lists is not bounded, but this is only used for
+         * diagnostics. */
+        for( uxFL = 0; uxFL < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFL++ )
+        {
+            for( uxSL = 0; uxSL < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSL++ )
+            {
+                for( pxBlock = pxFreeLists[ uxFL ][ uxSL ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xBlocks++;
+
+                    if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                    {
+                        xMaxSize = heapBLOCK_SIZE( pxBlock );
+                    }
+
+                    if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                    {
+                        xMinSize = heapBLOCK_SIZE( pxBlock );
+                    }
+                }
+            }
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = ( xBlocks > 0 ) ? xMinSize : 0;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    /* The share of the free memory that can not be handed out by a single
+     * allocation. */
+    if( pxHeapStats->xAvailableHeapSpaceInBytes > 0 )
+    {
+        pxHeapStats->xFragmentationPercent = ( size_t ) 100 - ( size_t ) ( ( ( uint32_t ) xMaxSize * 100UL ) / ( uint32_t ) pxHeapStats->xAvailableHeapSpaceInBytes );
+    }
+    else
+    {
+        pxHeapStats->xFragmentationPercent = 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFls( uint32_t ulValue )
+{
+    UBaseType_t uxBit = 0;
+
+    /* Binary search rather than a loop so the time taken does not depend on
+     * the value.  ARMv4T has no count leading zeros instruction. */
+    if( ( ulValue & 0xFFFF0000UL ) != 0UL )
+    {
+        uxBit += 16U;
+        ulValue >>= 16;
+    }
+
+    if( ( ulValue & 0xFF00UL ) != 0UL )
+    {
+        uxBit += 8U;
+        ulValue >>= 8;
+    }
+
+    if( ( ulValue & 0xF0UL ) != 0UL )
+    {
+        uxBit += 4U;
+        ulValue >>= 4;
+    }
+
+    if( ( ulValue & 0xCUL ) != 0UL )
+    {
+        uxBit += 2U;
+        ulValue >>= 2;
+    }
+
+    if( ( ulValue & 0x2UL ) != 0UL )
+    {
+        uxBit += 1U;
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFL,
+                              UBaseType_t * puxSL )
+{
+    UBaseType_t uxFL;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are split linearly. */
+        *puxFL = 0;
+        *puxSL = ( UBaseType_t ) ( xSize / ( heapSMALL_BLOCK_SIZE / heapSL_INDEX_COUNT ) );
+    }
+    else
+    {
+        uxFL = prvFls( ( uint32_t ) xSize );
+        *puxSL = ( UBaseType_t ) ( ( xSize >> ( uxFL - configTLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+        *puxFL = uxFL - ( heapFL_INDEX_SHIFT - 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+    BlockLink_t * pxFirstFreeBlock;
+    BlockLink_t * pxEndMarker;
+    uint8_t * pucAlignedHeap;
+    UBaseType_t uxFL, uxSL;
+
+    /* configTLSF_FL_INDEX_MAX is too small for configTOTAL_HEAP_SIZE if this
+     * assert fails. */
+    configASSERT( ( size_t ) configADJUSTED_HEAP_SIZE < ( ( size_t ) 1 << configTLSF_FL_INDEX_MAX ) );
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    pucAlignedHeap = ( uint8_t * ) ( ( ( portPOINTER_SIZE_TYPE ) & ucHeap[ portBYTE_ALIGNMENT - 1 ] ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) );
+
+    for( uxFL = 0; uxFL < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFL++ )
+    {
+        ulSLBitmap[ uxFL ] = 0UL;
+
+        for( uxSL = 0; uxSL < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSL++ )
+        {
+            pxFreeLists[ uxFL ][ uxSL ] = NULL;
+        }
+    }
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, less the header that marks the end of the heap.  The
+     * end marker is never free so blocks are never combined past it. */
+    pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+    pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+    pxFirstFreeBlock->xBlockSize = ( ( size_t ) configADJUSTED_HEAP_SIZE - heapSTRUCT_SIZE ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+    pxEndMarker = heapNEXT_PHYSICAL_BLOCK( pxFirstFreeBlock );
+    pxEndMarker->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+    pxEndMarker->xBlockSize = ( size_t ) 0;
+
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+    prvInsertBlockIntoFreeList( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
@@ -188,10 +188,14 @@ void vPortEndScheduler( void )
 	void vNonPreemptiveTick( void ) __irq;
 	void vNonPreemptiveTick( void ) __irq
 	{
+		traceISR_ENTER( configTICK_ISR_NUMBER );
+
 		/* Increment the tick count - this may make a delaying task ready
 		to run - but a context switch is not performed. */		
 		xTaskIncrementTick();
 
+		traceISR_EXIT();
+
 		T0IR = portTIMER_MATCH_ISR_BIT;				/* Clear the timer event */
 		VICVectAddr = portCLEAR_VIC_INTERRUPT;		/* Acknowledge the Interrupt */
 	}
@@ -208,6 +212,26 @@ void vPortEndScheduler( void )
 
 	  void vPreemptiveTick( void );
 
+	/*
+	 * Called by vPreemptiveTick once the context is saved.  The work is done
+	 * in C so the interrupt can be timed with traceISR_ENTER()/traceISR_EXIT().
+	 */
+	void vPortPreemptiveTickHandler( void );
+	void vPortPreemptiveTickHandler( void )
+	{
+		traceISR_ENTER( configTICK_ISR_NUMBER );
+
+		/* Increment the tick count - this may make a delayed task ready
+		to run. */
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			/* Find the highest priority task that is ready to run. */
+			vTaskSwitchContext();
+		}
+
+		traceISR_EXIT();
+	}
+
 #endif
 /*-----------------------------------------------------------*/
 
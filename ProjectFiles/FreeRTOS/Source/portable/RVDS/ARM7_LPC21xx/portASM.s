@@ -29,7 +29,7 @@
 	INCLUDE portmacro.inc
 
 	IMPORT	vTaskSwitchContext
-	IMPORT	xTaskIncrementTick
+	IMPORT	vPortPreemptiveTickHandler
 
 	EXPORT	vPortYieldProcessor
 	EXPORT	vPortStartFirstTask
@@ -102,16 +102,10 @@ vPreemptiveTick
 
 	portSAVE_CONTEXT					; Save the context of the current task.
 
-	LDR R0, =xTaskIncrementTick			; Increment the tick count.
-	MOV LR, PC							; This may make a delayed task ready
-	BX R0								; to run.
+	LDR R0, =vPortPreemptiveTickHandler	; Increment the tick count and
+	MOV LR, PC							; switch context if that made a
+	BX R0								; task ready to run.
 
-	CMP R0, #0
-	BEQ SkipContextSwitch
-	LDR R0, =vTaskSwitchContext			; Find the highest priority task that
-	MOV LR, PC							; is ready to run.
-	BX R0
-SkipContextSwitch
 	MOV R0, #T0MATCHBIT					; Clear the timer event
 	LDR R1, =T0IR
 	STR R0, [R1]
@@ -127,8 +127,8 @@ extern void vPortYield( void );
 extern void vPortEnterCritical( void );
 extern void vPortExitCritical( void );
 
-#define portENTER_CRITICAL()		vPortEnterCritical();
-#define portEXIT_CRITICAL()			vPortExitCritical();
+#define portENTER_CRITICAL()		do { vPortEnterCritical(); traceCRITICAL_ENTER(); } while( 0 )
+#define portEXIT_CRITICAL()			do { traceCRITICAL_EXIT(); vPortExitCritical(); } while( 0 )
 /*-----------------------------------------------------------*/
 
 /* Compiler specifics. */
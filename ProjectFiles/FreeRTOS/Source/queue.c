@@ -34,9 +34,13 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_QUEUE
+
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "mempool.h"
 
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
@@ -83,6 +87,17 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+/* Dynamically created queues take their structure and storage area from the
+ * queue pool when configMEMPOOL_QUEUE_COUNT is set and they fit in a block,
+ * see mempool.h. */
+#if ( configMEMPOOL_QUEUE_COUNT > 0 )
+    #define queueMALLOC( xSize )    pvMemPoolAllocWithFallback( &xMemPoolQueue, ( xSize ), portHEAP_CATEGORY_QUEUE )
+    #define queueFREE( pv )         vMemPoolFreeWithFallback( &xMemPoolQueue, ( pv ) )
+#else
+    #define queueMALLOC( xSize )    pvPortMallocCategory( ( xSize ), portHEAP_CATEGORY_QUEUE )
+    #define queueFREE( pv )         vPortFree( pv )
+#endif
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -92,6 +107,54 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+/* While a slot is reserved for writing no other item can be sent, as it would
+ * land in the reserved slot.  While the head slot is held for reading it can
+ * not be received, and nothing can be sent to the front of the queue or
+ * overwrite it. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueWRITE_RESERVED( pxQueue )    ( ( pxQueue )->pcWriteReserved != NULL )
+    #define queueREAD_HELD( pxQueue )         ( ( pxQueue )->pcReadHeld != NULL )
+#else
+    #define queueWRITE_RESERVED( pxQueue )    ( pdFALSE )
+    #define queueREAD_HELD( pxQueue )         ( pdFALSE )
+#endif
+
+#define queueCAN_SEND( pxQueue, xCopyPosition )                                                                          \
+    ( ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xCopyPosition ) == queueOVERWRITE ) ) &&      \
+      ( queueWRITE_RESERVED( pxQueue ) == pdFALSE ) &&                                                                  \
+      ( ( ( xCopyPosition ) == queueSEND_TO_BACK ) || ( queueREAD_HELD( pxQueue ) == pdFALSE ) ) )
+
+#define queueCAN_RECEIVE( pxQueue ) \
+    ( ( ( pxQueue )->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
+
+/* A deadline ordered queue keeps its items in fixed slots.  The heap index is
+ * an array of uxLength slot numbers: its first uxMessagesWaiting entries form a
+ * binary min-heap on the slot deadlines, the remaining entries are the free
+ * slots.  Deadlines are compared with taskDEADLINE_BEFORE(), modulo the tick
+ * counter wrap. */
+#if ( configUSE_DEADLINE_QUEUES == 1 )
+    #define queueIS_DEADLINE_ORDERED( pxQueue )    ( ( pxQueue )->puxHeapIndex != NULL )
+    #define queueHEAP_INDEX( pxQueue )             ( ( pxQueue )->puxHeapIndex )
+    #define queueDEADLINES( pxQueue )              ( ( TickType_t * ) &( ( pxQueue )->puxHeapIndex[ ( pxQueue )->uxLength ] ) )
+    #define queueSLOT( pxQueue, uxSlot )           ( ( pxQueue )->pcHead + ( ( uxSlot ) * ( pxQueue )->uxItemSize ) )
+#else
+    #define queueIS_DEADLINE_ORDERED( pxQueue )    ( pdFALSE )
+#endif
+
+/* Passes the deadline of the item at the head of a deadline ordered queue on
+ * to xTask, the task that is about to receive it. */
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+    #define queueINHERIT_HEAD_DEADLINE( pxQueue, xTask )                                                    \
+    {                                                                                                       \
+        if( queueIS_DEADLINE_ORDERED( pxQueue ) )                                                           \
+        {                                                                                                   \
+            vTaskDeadlineInherit( ( xTask ), queueDEADLINES( pxQueue )[ queueHEAP_INDEX( pxQueue )[ 0 ] ] ); \
+        }                                                                                                   \
+    }
+#else
+    #define queueINHERIT_HEAD_DEADLINE( pxQueue, xTask )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -130,6 +193,16 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        int8_t * pcWriteReserved; /*< The slot handed out by xQueueReserveSlot() and not yet committed, or NULL. */
+        int8_t * pcReadHeld;      /*< The head slot handed out by xQueuePeekSlot() and not yet released, or NULL. */
+    #endif
+
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        UBaseType_t * puxHeapIndex; /*< The heap index, followed by the deadline of the item in each slot, when the queue is deadline ordered.  NULL otherwise. */
+        uint8_t ucOverflowPolicy;   /*< What a deadline ordered queue does when an item is sent while it is full. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -176,18 +249,23 @@ typedef xQUEUE Queue_t;
 static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any data in a queue.
+ * Uses a critical section to determine if there is any data in a queue that
+ * can be received.
  *
- * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
+ * @return pdTRUE if the queue contains no items, or its head item is held by
+ * xQueuePeekSlot(), otherwise pdFALSE.
  */
 static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * Uses a critical section to determine if an item can be sent to a queue at
+ * xCopyPosition.
  *
- * @return pdTRUE if there is no space, otherwise pdFALSE;
+ * @return pdTRUE if there is no space, or a slot reservation prevents the send,
+ * otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -203,6 +281,13 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies the item prvCopyDataFromQueue() would copy, without removing it from
+ * the queue.
+ */
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -242,6 +327,81 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+/*
+ * Blocks the calling task on the send (xWaitToSend == pdTRUE) or receive event
+ * list of the queue, unless the queue changed state or the timeout expired
+ * since the caller last looked at it.  Either way the caller must loop back and
+ * test the queue again - xTaskCheckForTimeOut() sets *pxTicksToWait to 0 once
+ * the timeout has expired.
+ */
+static void prvWaitOnQueue( Queue_t * const pxQueue,
+                            const BaseType_t xWaitToSend,
+                            TimeOut_t * const pxTimeOut,
+                            TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items to the back of the queue, or from the front of the
+ * queue into pvBuffer, with at most two memcpy() calls.  The queue must have
+ * the space or the items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const void * pvItems,
+                                 const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_DEADLINE_QUEUES == 1 ) )
+
+/*
+ * Removes the highest priority task, if any, from pxEventList.  Returns pdTRUE
+ * if that task has a higher priority than the calling task.
+ */
+    static BaseType_t prvUnblockWaitingTask( List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+/*
+ * As prvUnblockWaitingTask(), but when the queue is locked only counts the
+ * event in *pcLock so the task that unlocks the queue can act on it.
+ */
+    static BaseType_t prvUnblockWaitingTaskFromISR( List_t * const pxEventList,
+                                                    volatile int8_t * const pcLock ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Make the reserved slot the tail item of the queue, and the held slot free
+ * space again.  Both must be called with the queue in a critical section.
+ */
+    static void prvCommitWriteSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvReleaseReadSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_DEADLINE_QUEUES == 1 )
+
+/*
+ * Restore the heap order after the deadline of the entry at uxPosition of the
+ * heap index became earlier (sift up) or later (sift down) than it should be.
+ * uxHeapSize is the number of entries in the heap.
+ */
+    static void prvDeadlineHeapSiftUp( Queue_t * const pxQueue,
+                                       UBaseType_t uxPosition ) PRIVILEGED_FUNCTION;
+    static void prvDeadlineHeapSiftDown( Queue_t * const pxQueue,
+                                         UBaseType_t uxPosition,
+                                         const UBaseType_t uxHeapSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds an item to a deadline ordered queue, evicting the latest deadline item
+ * into pvEvictedItem if the queue is full and its overflow policy allows it.
+ * Returns pdPASS, queueITEM_EVICTED or errQUEUE_FULL.  Must be called from a
+ * critical section.
+ */
+    static BaseType_t prvCopyDataToDeadlineQueue( Queue_t * const pxQueue,
+                                                  const void * pvItemToQueue,
+                                                  const TickType_t xDeadline,
+                                                  void * const pvEvictedItem ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -285,6 +445,13 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+                {
+                    pxQueue->pcWriteReserved = NULL;
+                    pxQueue->pcReadHeld = NULL;
+                }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -423,7 +590,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
              * are greater than or equal to the pointer to char requirements the cast
              * is safe.  In other cases alignment requirements are not strict (one or
              * two bytes). */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+            pxNewQueue = ( Queue_t * ) queueMALLOC( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
 
             if( pxNewQueue != NULL )
             {
@@ -489,6 +656,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        {
+            pxNewQueue->puxHeapIndex = NULL;
+        }
+    #endif
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -814,6 +988,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
             configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -831,7 +1006,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( queueCAN_SEND( pxQueue, xCopyPosition ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -972,7 +1147,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -1026,6 +1201,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1050,7 +1226,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * post). */
     uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( queueCAN_SEND( pxQueue, xCopyPosition ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1380,11 +1556,14 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         {
             const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            /* Is there data in the queue now that is not held by
+             * xQueuePeekSlot()?  To be running the calling task must be the
+             * highest priority task wanting to access the queue. */
+            if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
             {
-                /* Data available, remove one item. */
+                /* Data available, remove one item.  The calling task serves
+                 * it with its deadline if it was sent with an earlier one. */
+                queueINHERIT_HEAD_DEADLINE( pxQueue, NULL );
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
@@ -1717,7 +1896,6 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
     /* Check the pointer is not NULL. */
@@ -1747,17 +1925,10 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                /* This function is only peeking the data, not removing it. */
+                prvPeekDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_PEEK( pxQueue );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
                 if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
@@ -1894,7 +2065,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
         const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
         /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueREAD_HELD( pxQueue ) == pdFALSE ) )
         {
             const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1962,7 +2133,6 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 {
     BaseType_t xReturn;
     UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
@@ -1992,11 +2162,8 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
         {
             traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            /* Nothing is actually being removed from the queue. */
+            prvPeekDataFromQueue( pxQueue, pvBuffer );
 
             xReturn = pdPASS;
         }
@@ -2012,189 +2179,1431 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
-
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+static void prvWaitOnQueue( Queue_t * const pxQueue,
+                            const BaseType_t xWaitToSend,
+                            TimeOut_t * const pxTimeOut,
+                            TickType_t * const pxTicksToWait )
 {
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    BaseType_t xMustBlock;
 
-    configASSERT( pxQueue );
+    /* Interrupts and other tasks can use the queue now the critical
+     * section has been exited. */
+    vTaskSuspendAll();
+    prvLockQueue( pxQueue );
 
-    taskENTER_CRITICAL();
+    if( xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait ) == pdFALSE )
     {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
-
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        if( xWaitToSend != pdFALSE )
         {
-            vQueueUnregisterQueue( pxQueue );
+            xMustBlock = prvIsQueueFull( pxQueue, queueSEND_TO_BACK );
         }
-    #endif
-
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        else
         {
-            /* The queue can only have been allocated dynamically - free it
-             * again. */
-            vPortFree( pxQueue );
+            xMustBlock = prvIsQueueEmpty( pxQueue );
         }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+        if( xMustBlock != pdFALSE )
         {
-            /* The queue could have been allocated statically or dynamically, so
-             * check before attempting to free the memory. */
-            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            if( xWaitToSend != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), *pxTicksToWait );
+            }
+            else
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), *pxTicksToWait );
+            }
+
+            prvUnlockQueue( pxQueue );
+
+            if( xTaskResumeAll() == pdFALSE )
             {
-                vPortFree( pxQueue );
+                portYIELD_WITHIN_API();
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        else
         {
-            /* The queue must have been statically allocated, so is not going to be
-             * deleted.  Avoid compiler warnings about the unused parameter. */
-            ( void ) pxQueue;
+            /* Try again. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
         }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+    else
+    {
+        /* Timed out, the caller makes one last attempt with a zero block
+         * time. */
+        prvUnlockQueue( pxQueue );
+        ( void ) xTaskResumeAll();
+    }
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_DEADLINE_QUEUES == 1 ) )
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    static BaseType_t prvUnblockWaitingTask( List_t * const pxEventList )
     {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+        BaseType_t xReturn = pdFALSE;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+        if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+        {
+            xReturn = xTaskRemoveFromEventList( pxEventList );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    static BaseType_t prvUnblockWaitingTaskFromISR( List_t * const pxEventList,
+                                                    volatile int8_t * const pcLock )
     {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
+        BaseType_t xReturn = pdFALSE;
+        const int8_t cLock = *pcLock;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+        if( cLock == queueUNLOCKED )
+        {
+            xReturn = prvUnblockWaitingTask( pxEventList );
+        }
+        else
+        {
+            /* Increment the lock count so the task that unlocks the queue
+             * knows the queue changed while it was locked. */
+            configASSERT( cLock != queueINT8_MAX );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            *pcLock = ( int8_t ) ( cLock + 1 );
+        }
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( configUSE_QUEUE_ZERO_COPY == 1 ) || ( configUSE_DEADLINE_QUEUES == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    static void prvCommitWriteSlot( Queue_t * const pxQueue )
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        configASSERT( pxQueue->pcWriteReserved == pxQueue->pcWriteTo );
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            pxQueue->pcWriteTo = pxQueue->pcHead;
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxHighestPriorityOfWaitingTasks;
+        pxQueue->uxMessagesWaiting++;
+        pxQueue->pcWriteReserved = NULL;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_MUTEXES */
+    static void prvReleaseReadSlot( Queue_t * const pxQueue )
+    {
+        configASSERT( pxQueue->pcReadHeld != NULL );
+
+        /* The held slot was the one after pcReadFrom, so this is exactly the
+         * update prvCopyDataFromQueue() would have made. */
+        pxQueue->u.xQueue.pcReadFrom = pxQueue->pcReadHeld;
+        pxQueue->uxMessagesWaiting--;
+        pxQueue->pcReadHeld = NULL;
+    }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
-{
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
+    BaseType_t xQueueReserveSlot( QueueHandle_t xQueue,
+                                  void ** const ppvSlot,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
 
-    /* This function is called from a critical section. */
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
 
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                /* Committing a slot does not notify a queue set. */
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+        #endif
 
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
             {
-                if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
                 {
-                    /* The mutex is no longer being held. */
-                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                    pxQueue->pcWriteReserved = pxQueue->pcWriteTo;
+                    *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return errQUEUE_FULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
                 }
                 else
                 {
+                    /* Entry time was already set. */
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        #endif /* configUSE_MUTEXES */
+            taskEXIT_CRITICAL();
+
+            prvWaitOnQueue( pxQueue, pdTRUE, &xTimeOut, &xTicksToWait );
+        } /*lint -restore */
     }
-    else if( xPosition == queueSEND_TO_BACK )
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReserveSlotFromISR( QueueHandle_t xQueue,
+                                         void ** const ppvSlot )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
-        {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
-        }
-        else
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+        #endif
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
+            {
+                pxQueue->pcWriteReserved = pxQueue->pcWriteTo;
+                *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueCommitSlot( QueueHandle_t xQueue )
+    {
+        BaseType_t xYieldRequired;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            traceQUEUE_SEND( pxQueue );
+            prvCommitWriteSlot( pxQueue );
+
+            /* The queue now has data, and may have space that the reservation
+             * was keeping other senders from. */
+            xYieldRequired = prvUnblockWaitingTask( &( pxQueue->xTasksWaitingToReceive ) );
+
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            {
+                if( prvUnblockWaitingTask( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueCommitSlotFromISR( QueueHandle_t xQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xTaskWoken;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCommitWriteSlot( pxQueue );
+
+            /* cTxLock counts items added while the queue is locked, cRxLock
+             * space made available while it is locked. */
+            xTaskWoken = prvUnblockWaitingTaskFromISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ) );
+
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+            {
+                if( prvUnblockWaitingTaskFromISR( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ) ) != pdFALSE )
+                {
+                    xTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueuePeekSlot( QueueHandle_t xQueue,
+                               void ** const ppvSlot,
+                               TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( queueCAN_RECEIVE( pxQueue ) )
+                {
+                    pxQueue->pcReadHeld = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pxQueue->pcReadHeld >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                    {
+                        pxQueue->pcReadHeld = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    *ppvSlot = ( void * ) pxQueue->pcReadHeld;
+                    traceQUEUE_PEEK( pxQueue );
+
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            prvWaitOnQueue( pxQueue, pdFALSE, &xTimeOut, &xTicksToWait );
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueuePeekSlotFromISR( QueueHandle_t xQueue,
+                                      void ** const ppvSlot )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( queueCAN_RECEIVE( pxQueue ) )
+            {
+                pxQueue->pcReadHeld = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                if( pxQueue->pcReadHeld >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                {
+                    pxQueue->pcReadHeld = pxQueue->pcHead;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                *ppvSlot = ( void * ) pxQueue->pcReadHeld;
+                traceQUEUE_PEEK_FROM_ISR( pxQueue );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+                xReturn = errQUEUE_EMPTY;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueReleaseSlot( QueueHandle_t xQueue )
+    {
+        BaseType_t xYieldRequired;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            traceQUEUE_RECEIVE( pxQueue );
+            prvReleaseReadSlot( pxQueue );
+
+            /* The queue now has space, and any remaining items can be received
+             * again now the head is no longer held. */
+            xYieldRequired = prvUnblockWaitingTask( &( pxQueue->xTasksWaitingToSend ) );
+
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                if( prvUnblockWaitingTask( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueReleaseSlotFromISR( QueueHandle_t xQueue,
+                                   BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xTaskWoken;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            prvReleaseReadSlot( pxQueue );
+
+            xTaskWoken = prvUnblockWaitingTaskFromISR( &( pxQueue->xTasksWaitingToSend ), &( pxQueue->cRxLock ) );
+
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                if( prvUnblockWaitingTaskFromISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ) ) != pdFALSE )
+                {
+                    xTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_QUEUES == 1 )
+
+    static void prvDeadlineHeapSiftUp( Queue_t * const pxQueue,
+                                       UBaseType_t uxPosition )
+    {
+        UBaseType_t * const puxHeapIndex = queueHEAP_INDEX( pxQueue );
+        const TickType_t * const pxDeadlines = queueDEADLINES( pxQueue );
+        const UBaseType_t uxSlot = puxHeapIndex[ uxPosition ];
+        const TickType_t xDeadline = pxDeadlines[ uxSlot ];
+        UBaseType_t uxParent;
+
+        while( uxPosition > ( UBaseType_t ) 0 )
+        {
+            uxParent = ( uxPosition - ( UBaseType_t ) 1 ) >> 1;
+
+            if( taskDEADLINE_BEFORE( xDeadline, pxDeadlines[ puxHeapIndex[ uxParent ] ] ) )
+            {
+                puxHeapIndex[ uxPosition ] = puxHeapIndex[ uxParent ];
+                uxPosition = uxParent;
+            }
+            else
+            {
+                /* Heap order restored. */
+                break;
+            }
+        }
+
+        puxHeapIndex[ uxPosition ] = uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDeadlineHeapSiftDown( Queue_t * const pxQueue,
+                                         UBaseType_t uxPosition,
+                                         const UBaseType_t uxHeapSize )
+    {
+        UBaseType_t * const puxHeapIndex = queueHEAP_INDEX( pxQueue );
+        const TickType_t * const pxDeadlines = queueDEADLINES( pxQueue );
+        const UBaseType_t uxSlot = puxHeapIndex[ uxPosition ];
+        const TickType_t xDeadline = pxDeadlines[ uxSlot ];
+        UBaseType_t uxChild = ( uxPosition << 1 ) + ( UBaseType_t ) 1;
+
+        while( uxChild < uxHeapSize )
+        {
+            /* Follow the child with the earlier deadline. */
+            if( ( ( uxChild + ( UBaseType_t ) 1 ) < uxHeapSize ) &&
+                taskDEADLINE_BEFORE( pxDeadlines[ puxHeapIndex[ uxChild + ( UBaseType_t ) 1 ] ], pxDeadlines[ puxHeapIndex[ uxChild ] ] ) )
+            {
+                uxChild++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( taskDEADLINE_BEFORE( pxDeadlines[ puxHeapIndex[ uxChild ] ], xDeadline ) )
+            {
+                puxHeapIndex[ uxPosition ] = puxHeapIndex[ uxChild ];
+                uxPosition = uxChild;
+                uxChild = ( uxPosition << 1 ) + ( UBaseType_t ) 1;
+            }
+            else
+            {
+                /* Heap order restored. */
+                break;
+            }
+        }
+
+        puxHeapIndex[ uxPosition ] = uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCopyDataToDeadlineQueue( Queue_t * const pxQueue,
+                                                  const void * pvItemToQueue,
+                                                  const TickType_t xDeadline,
+                                                  void * const pvEvictedItem )
+    {
+        UBaseType_t * const puxHeapIndex = queueHEAP_INDEX( pxQueue );
+        TickType_t * const pxDeadlines = queueDEADLINES( pxQueue );
+        UBaseType_t uxPosition, uxLatest, uxSlot;
+        BaseType_t xReturn = pdPASS;
+
+        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        {
+            /* Take the first free slot and add it at the end of the heap. */
+            uxPosition = pxQueue->uxMessagesWaiting;
+            pxQueue->uxMessagesWaiting++;
+        }
+        else if( pxQueue->ucOverflowPolicy == queueOVERFLOW_EVICT_LATEST )
+        {
+            /* The latest deadline is held by one of the leaves, which are the
+             * second half of a full heap. */
+            uxLatest = pxQueue->uxLength >> 1;
+
+            for( uxPosition = uxLatest + ( UBaseType_t ) 1; uxPosition < pxQueue->uxLength; uxPosition++ )
+            {
+                if( taskDEADLINE_BEFORE( pxDeadlines[ puxHeapIndex[ uxLatest ] ], pxDeadlines[ puxHeapIndex[ uxPosition ] ] ) )
+                {
+                    uxLatest = uxPosition;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( taskDEADLINE_BEFORE( xDeadline, pxDeadlines[ puxHeapIndex[ uxLatest ] ] ) )
+            {
+                if( pvEvictedItem != NULL )
+                {
+                    ( void ) memcpy( pvEvictedItem, ( void * ) queueSLOT( pxQueue, puxHeapIndex[ uxLatest ] ), ( size_t ) pxQueue->uxItemSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The new item takes over the leaf.  Its deadline is earlier
+                 * so it can only need to move up. */
+                uxPosition = uxLatest;
+                xReturn = queueITEM_EVICTED;
+            }
+            else
+            {
+                /* The new item would itself be the one to evict. */
+                uxPosition = uxLatest;
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        else
+        {
+            uxPosition = ( UBaseType_t ) 0;
+            xReturn = errQUEUE_FULL;
+        }
+
+        if( xReturn != errQUEUE_FULL )
+        {
+            uxSlot = puxHeapIndex[ uxPosition ];
+            ( void ) memcpy( ( void * ) queueSLOT( pxQueue, uxSlot ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+            pxDeadlines[ uxSlot ] = xDeadline;
+            prvDeadlineHeapSiftUp( pxQueue, uxPosition );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength,
+                                                   const UBaseType_t uxItemSize,
+                                                   const uint8_t ucOverflowPolicy )
+        {
+            Queue_t * pxNewQueue = NULL;
+            size_t xOrderSizeInBytes, xQueueSizeInBytes;
+            uint8_t * pucQueueStorage;
+            UBaseType_t ux;
+
+            configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+            configASSERT( ( ucOverflowPolicy == queueOVERFLOW_REJECT_NEWEST ) || ( ucOverflowPolicy == queueOVERFLOW_EVICT_LATEST ) );
+
+            if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+                /* Check for multiplication overflow. */
+                ( ( SIZE_MAX / uxQueueLength ) >= ( uxItemSize + sizeof( TickType_t ) + sizeof( UBaseType_t ) ) ) &&
+                /* Check for addition overflow. */
+                ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * ( uxItemSize + sizeof( TickType_t ) + sizeof( UBaseType_t ) ) ) ) )
+            {
+                /* The heap index and the deadlines go straight after the queue
+                 * structure, where they are aligned, and the items after them. */
+                xOrderSizeInBytes = ( size_t ) uxQueueLength * ( sizeof( TickType_t ) + sizeof( UBaseType_t ) );
+                xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize );
+
+                pxNewQueue = ( Queue_t * ) queueMALLOC( sizeof( Queue_t ) + xOrderSizeInBytes + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment in xQueueGenericCreate(). */
+
+                if( pxNewQueue != NULL )
+                {
+                    pucQueueStorage = ( uint8_t * ) pxNewQueue;
+                    pucQueueStorage += sizeof( Queue_t );
+
+                    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                        {
+                            pxNewQueue->ucStaticallyAllocated = pdFALSE;
+                        }
+                    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                    prvInitialiseNewQueue( uxQueueLength, uxItemSize, pucQueueStorage + xOrderSizeInBytes, queueQUEUE_TYPE_BASE, pxNewQueue );
+
+                    pxNewQueue->puxHeapIndex = ( UBaseType_t * ) pucQueueStorage; /*lint !e9087 !e9079 The storage follows the queue structure so is aligned for it. */
+                    pxNewQueue->ucOverflowPolicy = ucOverflowPolicy;
+
+                    /* Every slot starts out free.  The index only ever gets
+                     * permuted, so a queue reset leaves it valid. */
+                    for( ux = ( UBaseType_t ) 0; ux < uxQueueLength; ux++ )
+                    {
+                        pxNewQueue->puxHeapIndex[ ux ] = ux;
+                    }
+                }
+                else
+                {
+                    traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewQueue;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSendWithDeadline( QueueHandle_t xQueue,
+                                       const void * const pvItemToQueue,
+                                       const TickType_t xDeadline,
+                                       void * const pvEvictedItem,
+                                       TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE, xReturn;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemToQueue );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+        #endif
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvCopyDataToDeadlineQueue( pxQueue, pvItemToQueue, xDeadline, pvEvictedItem );
+
+                if( xReturn != errQUEUE_FULL )
+                {
+                    traceQUEUE_SEND( pxQueue );
+
+                    /* A task blocked on the queue takes the deadline of the
+                     * item it will receive before it is readied, so it is
+                     * placed in the ready list on that deadline. */
+                    #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+                        {
+                            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                            {
+                                queueINHERIT_HEAD_DEADLINE( pxQueue, listGET_OWNER_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif
+
+                    if( prvUnblockWaitingTask( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    taskEXIT_CRITICAL();
+                    return xReturn;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return errQUEUE_FULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            prvWaitOnQueue( pxQueue, pdTRUE, &xTimeOut, &xTicksToWait );
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSendWithDeadlineFromISR( QueueHandle_t xQueue,
+                                              const void * const pvItemToQueue,
+                                              const TickType_t xDeadline,
+                                              void * const pvEvictedItem,
+                                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemToQueue );
+        configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) );
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+        #endif
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = prvCopyDataToDeadlineQueue( pxQueue, pvItemToQueue, xDeadline, pvEvictedItem );
+
+            if( xReturn != errQUEUE_FULL )
+            {
+                traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+                #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            queueINHERIT_HEAD_DEADLINE( pxQueue, listGET_OWNER_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif
+
+                if( ( prvUnblockWaitingTaskFromISR( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->cTxLock ) ) != pdFALSE ) &&
+                    ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_DEADLINE_QUEUES */
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const void * pvItems,
+                                 const UBaseType_t uxItemCount )
+{
+    const int8_t * pcItems = ( const int8_t * ) pvItems;
+    size_t xBytesLeft = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xChunk;
+
+    while( xBytesLeft > ( size_t ) 0 )
+    {
+        /* Copy up to the end of the storage area, then wrap. */
+        xChunk = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+        if( xChunk > xBytesLeft )
+        {
+            xChunk = xBytesLeft;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xChunk );
+        pxQueue->pcWriteTo += xChunk; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        pcItems += xChunk;
+        xBytesLeft -= xChunk;
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   void * const pvBuffer,
+                                   const UBaseType_t uxItemCount )
+{
+    int8_t * pcBuffer = ( int8_t * ) pvBuffer;
+    int8_t * pcNextItem;
+    size_t xBytesLeft = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xChunk;
+
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        if( queueIS_DEADLINE_ORDERED( pxQueue ) )
+        {
+            /* The items are not stored in order, take them off the heap one
+             * at a time. */
+            while( xBytesLeft > ( size_t ) 0 )
+            {
+                prvCopyDataFromQueue( pxQueue, ( void * ) pcBuffer );
+                pxQueue->uxMessagesWaiting--;
+                pcBuffer += pxQueue->uxItemSize;
+                xBytesLeft -= ( size_t ) pxQueue->uxItemSize;
+            }
+        }
+        else
+    #endif /* configUSE_DEADLINE_QUEUES */
+    {
+        /* pcReadFrom points to the last item read, the first item to copy is
+         * the one after it. */
+        pcNextItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pcNextItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pcNextItem = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        while( xBytesLeft > ( size_t ) 0 )
+        {
+            xChunk = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcNextItem );
+
+            if( xChunk > xBytesLeft )
+            {
+                xChunk = xBytesLeft;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcNextItem, xChunk );
+            pcNextItem += xChunk;
+            pcBuffer += xChunk;
+            xBytesLeft -= xChunk;
+            pxQueue->u.xQueue.pcReadFrom = pcNextItem - pxQueue->uxItemSize;
+
+            if( pcNextItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+            {
+                pcNextItem = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxQueue->uxMessagesWaiting -= uxItemCount;
+    }
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * const pvItems,
+                                 const UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxItemsSent, uxWoken;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( queueIS_DEADLINE_ORDERED( pxQueue ) == pdFALSE );
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        {
+            /* A batch does not notify a queue set. */
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        }
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
+            {
+                uxItemsSent = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+                if( uxItemsSent > uxItemCount )
+                {
+                    uxItemsSent = uxItemCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_SEND( pxQueue );
+                prvCopyItemsToQueue( pxQueue, pvItems, uxItemsSent );
+
+                /* One wake decision for the whole batch: unblock up to one
+                 * waiting receiver per item sent, then yield at most once. */
+                xYieldRequired = pdFALSE;
+
+                for( uxWoken = ( UBaseType_t ) 0U;
+                     ( uxWoken < uxItemsSent ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE );
+                     uxWoken++ )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsSent;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                taskEXIT_CRITICAL();
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return ( UBaseType_t ) 0U;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        prvWaitOnQueue( pxQueue, pdTRUE, &xTimeOut, &xTicksToWait );
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * const pvBuffer,
+                                    const UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxItemsReceived, uxWoken;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( queueCAN_RECEIVE( pxQueue ) )
+            {
+                uxItemsReceived = pxQueue->uxMessagesWaiting;
+
+                if( uxItemsReceived > uxMaxItems )
+                {
+                    uxItemsReceived = uxMaxItems;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The head item has the earliest deadline of the batch. */
+                queueINHERIT_HEAD_DEADLINE( pxQueue, NULL );
+                prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemsReceived );
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* One wake decision for the whole batch: unblock up to one
+                 * waiting sender per slot freed, then yield at most once. */
+                xYieldRequired = pdFALSE;
+
+                for( uxWoken = ( UBaseType_t ) 0U;
+                     ( uxWoken < uxItemsReceived ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE );
+                     uxWoken++ )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsReceived;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                taskEXIT_CRITICAL();
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return ( UBaseType_t ) 0U;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                /* Entry time was already set. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        prvWaitOnQueue( pxQueue, pdFALSE, &xTimeOut, &xTicksToWait );
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        {
+            vQueueUnregisterQueue( pxQueue );
+        }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The queue can only have been allocated dynamically - free it
+             * again. */
+            queueFREE( pxQueue );
+        }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The queue could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                queueFREE( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        {
+            /* The queue must have been statically allocated, so is not going to be
+             * deleted.  Avoid compiler warnings about the unused parameter. */
+            ( void ) pxQueue;
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
+
+    /* This function is called from a critical section. */
+
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+            {
+                if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                {
+                    /* The mutex is no longer being held. */
+                    xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_MUTEXES */
+    }
+    else if( xPosition == queueSEND_TO_BACK )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
         {
             mtCOVERAGE_TEST_MARKER();
         }
@@ -2243,6 +3652,25 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer )
 {
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        if( queueIS_DEADLINE_ORDERED( pxQueue ) )
+        {
+            UBaseType_t * const puxHeapIndex = queueHEAP_INDEX( pxQueue );
+            const UBaseType_t uxLast = pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1;
+            const UBaseType_t uxSlot = puxHeapIndex[ 0 ];
+
+            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) queueSLOT( pxQueue, uxSlot ), ( size_t ) pxQueue->uxItemSize );
+
+            /* Move the last heap entry to the root and hand the slot back to
+             * the free part of the index.  The caller decrements
+             * uxMessagesWaiting. */
+            puxHeapIndex[ 0 ] = puxHeapIndex[ uxLast ];
+            puxHeapIndex[ uxLast ] = uxSlot;
+            prvDeadlineHeapSiftDown( pxQueue, ( UBaseType_t ) 0, uxLast );
+        }
+        else
+    #endif /* configUSE_DEADLINE_QUEUES */
+
     if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
     {
         pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
@@ -2261,6 +3689,27 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    #if ( configUSE_DEADLINE_QUEUES == 1 )
+        if( queueIS_DEADLINE_ORDERED( pxQueue ) )
+        {
+            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) queueSLOT( pxQueue, queueHEAP_INDEX( pxQueue )[ 0 ] ), ( size_t ) pxQueue->uxItemSize );
+        }
+        else
+    #endif /* configUSE_DEADLINE_QUEUES */
+    {
+        /* Remember the read position so it can be reset after the data is
+         * read from the queue. */
+        int8_t * const pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+
+        prvCopyDataFromQueue( pxQueue, pvBuffer );
+        pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+    }
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2387,7 +3836,7 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+        if( queueCAN_RECEIVE( pxQueue ) == pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2422,13 +3871,14 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue )
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue,
+                                  const BaseType_t xCopyPosition )
 {
     BaseType_t xReturn;
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueCAN_SEND( pxQueue, xCopyPosition ) == pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2477,7 +3927,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
          * between the check to see if the queue is full and blocking on the queue. */
         portDISABLE_INTERRUPTS();
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
             {
                 /* The queue is full - do we want to block or just leave without
                  * posting? */
@@ -35,6 +35,9 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_STREAM_BUFFER
+
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
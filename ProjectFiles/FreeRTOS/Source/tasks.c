@@ -35,17 +35,23 @@
  * task.h is included from an application file. */
 #define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID    criticalFILE_TASKS
+
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "mempool.h"
+
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+    #include "let.h"
+#endif
 
 #include "main.h"
 #include "GPIO.h"
 
-extern performanceEvaluation_t performanceEvaluation;
-
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -83,6 +89,7 @@ extern performanceEvaluation_t performanceEvaluation;
  * is used purely for checking the high water mark for tasks.
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
+#define tskSTACK_FILL_WORD                        ( ( StackType_t ) 0xa5a5a5a5UL )
 
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
@@ -92,12 +99,25 @@ extern performanceEvaluation_t performanceEvaluation;
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
  * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) || ( configUSE_STACK_WATERMARKS == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
 #endif
 
+/*
+ * Dynamically created tasks take their TCB from the TCB pool when
+ * configMEMPOOL_TCB_COUNT is set, see mempool.h.  Stacks always come from the
+ * heap.
+ */
+#if ( configMEMPOOL_TCB_COUNT > 0 )
+    #define taskMALLOC_TCB()         ( ( TCB_t * ) pvMemPoolAllocWithFallback( &xMemPoolTCB, sizeof( TCB_t ), portHEAP_CATEGORY_TCB ) )
+    #define taskFREE_TCB( pxTCB )    vMemPoolFreeWithFallback( &xMemPoolTCB, ( pxTCB ) )
+#else
+    #define taskMALLOC_TCB()         ( ( TCB_t * ) pvPortMallocCategory( sizeof( TCB_t ), portHEAP_CATEGORY_TCB ) )
+    #define taskFREE_TCB( pxTCB )    vPortFree( pxTCB )
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -121,7 +141,12 @@ extern performanceEvaluation_t performanceEvaluation;
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Tasks have no priority under EDF, the ready tasks are all held in
+ * xReadyTasksListEDF.  See the scheduling policy operations below. */
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -198,7 +223,7 @@ extern performanceEvaluation_t performanceEvaluation;
         }                                                                                              \
     }
 
-#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+#endif /* configUSE_EDF_SCHEDULER, configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
@@ -220,27 +245,164 @@ extern performanceEvaluation_t performanceEvaluation;
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Scheduling policy operations.  The rest of the kernel only goes through
+ * these to enqueue a ready task, dequeue it again, pick the next task to run
+ * and decide whether a task that has just been readied (wake decision) or the
+ * tick (preemption check) should preempt the running task.
+ *
+ * When configUSE_EDF_SCHEDULER is 1 every policy selected by
+ * configSCHEDULING_POLICY keeps the ready tasks in xReadyTasksListEDF, sorted
+ * on the value of their xStateListItem, so the task to run is always the head
+ * of that list.  The policies only differ in the key stored in that value:
+ *
+ * EDF - the absolute deadline of the current job.
+ * RM  - the period, which gives the rate monotonic priority assignment.
+ * DM  - the relative deadline, which gives the deadline monotonic assignment.
+ * LLF - the absolute deadline minus the remaining execution budget.  This is
+ *       the laxity plus the current tick count, and as the tick count is the
+ *       same for every task sorting on it sorts on laxity.  Only the key of the
+ *       running task changes as time passes, see prvLaxityTickCheck().
+ * EDZL - the absolute deadline, until the laxity of the job reaches zero.  The
+ *       key then becomes the LLF one, which is not later than the current tick
+ *       count and so sorts ahead of every job that still has laxity.
+ *
+ * Tasks that are not periodic, the idle task included, get a key of
+ * portMAX_DELAY so they only run in the background.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Value held in xTaskPeriod by tasks that were not created periodic. */
+    #define taskNON_PERIODIC    portMAX_DELAY
+
+/* Values of ucLetState.  A LET task whose job has not completed by the next
+ * release has the latch of its inputs deferred until it does. */
+    #define taskLET_OFF              ( ( uint8_t ) 0 )
+    #define taskLET_JOB_RUNNING      ( ( uint8_t ) 1 )
+    #define taskLET_JOB_DONE         ( ( uint8_t ) 2 )
+    #define taskLET_LATCH_PENDING    ( ( uint8_t ) 3 )
+
+/* Policies that need to know how much execution time the current job of each
+ * task has left. */
+    #if ( ( configSCHEDULING_POLICY == schedPOLICY_LLF ) || ( configSCHEDULING_POLICY == schedPOLICY_EDZL ) )
+        #define taskPOLICY_USES_BUDGET    1
+    #else
+        #define taskPOLICY_USES_BUDGET    0
+    #endif
+
+    #if ( configSCHEDULING_POLICY == schedPOLICY_EDF )
+        #define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskDeadline )
+    #elif ( configSCHEDULING_POLICY == schedPOLICY_RM )
+        #define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskPeriod )
+    #elif ( configSCHEDULING_POLICY == schedPOLICY_DM )
+        #define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskRelativeDeadline )
+    #elif ( configSCHEDULING_POLICY == schedPOLICY_LLF )
+        #define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskDeadline - ( pxTCB )->xTaskRemainingBudget )
+    #elif ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+        #define taskPOLICY_KEY( pxTCB )    ( ( pxTCB )->xTaskDeadline - ( ( ( pxTCB )->ucZeroLaxity != pdFALSE ) ? ( pxTCB )->xTaskRemainingBudget : ( TickType_t ) 0U ) )
+    #endif
+
+/* Jobs are checked for zero laxity every time they become ready, on top of
+ * the check made from the tick interrupt. */
+    #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+        #define taskPOLICY_ON_READY( pxTCB )    prvCheckZeroLaxity( pxTCB )
+    #else
+        #define taskPOLICY_ON_READY( pxTCB )
+    #endif
+
+    #define taskPOLICY_ENQUEUE_READY( pxTCB )                                                \
+    {                                                                                        \
+        taskPOLICY_ON_READY( pxTCB );                                                        \
+        listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), taskPOLICY_KEY( pxTCB ) ); \
+        vListInsert( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) );             \
+    }
+
+    #define taskPOLICY_DEQUEUE( pxTCB )    ( void ) uxListRemove( &( ( pxTCB )->xStateListItem ) )
+
+    #define taskPOLICY_SELECT_NEXT_TASK()                                                          \
+    {                                                                                              \
+        configASSERT( listCURRENT_LIST_LENGTH( &( xReadyTasksListEDF ) ) > ( UBaseType_t ) 0 );    \
+        pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xReadyTasksListEDF ) );         \
+    }
+
+/* A readied task only preempts the running task if its key is strictly
+ * smaller, ties are left to run in release order. */
+    #define taskPOLICY_PREEMPTS( pxTCB )            ( taskPOLICY_KEY( pxTCB ) < taskPOLICY_KEY( pxCurrentTCB ) )
+    #define taskPOLICY_PREEMPTS_OR_TIES( pxTCB )    taskPOLICY_PREEMPTS( pxTCB )
+
+/* Laxities drift against each other from one tick to the next, so under LLF
+ * the checks made from the tick interrupt also need the key to be smaller by
+ * more than configLAXITY_HYSTERESIS_TICKS, written so that neither side can
+ * wrap.  Tasks readied by an event, and the choice of the first task to run
+ * before the scheduler starts, are compared without it. */
+    #if ( configSCHEDULING_POLICY == schedPOLICY_LLF )
+        #define taskPOLICY_PREEMPTS_AT_TICK( pxTCB )                                                                   \
+    ( ( taskPOLICY_KEY( pxCurrentTCB ) > ( TickType_t ) configLAXITY_HYSTERESIS_TICKS ) &&                             \
+      ( taskPOLICY_KEY( pxTCB ) < ( taskPOLICY_KEY( pxCurrentTCB ) - ( TickType_t ) configLAXITY_HYSTERESIS_TICKS ) ) )
+    #else
+        #define taskPOLICY_PREEMPTS_AT_TICK( pxTCB )    taskPOLICY_PREEMPTS( pxTCB )
+    #endif
+    #define taskPOLICY_PREEMPTS_OR_TIES_AT_TICK( pxTCB )    taskPOLICY_PREEMPTS_AT_TICK( pxTCB )
+
+    #if ( taskPOLICY_USES_BUDGET == 1 )
+        #define taskPOLICY_TICK_PREEMPTS()    prvLaxityTickCheck()
+    #else
+        #define taskPOLICY_TICK_PREEMPTS()    pdFALSE
+    #endif
+
+/* There is no priority to order event lists on.  Every task gets the same
+ * value, so the tasks waiting on an event are woken in the order they blocked. */
+    #define taskEVENT_LIST_ITEM_VALUE( pxTCB )    ( ( TickType_t ) 0U )
+
+#else /* configUSE_EDF_SCHEDULER */
+
+    #define taskPOLICY_ENQUEUE_READY( pxTCB )                                                          \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
+    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+
+    #define taskPOLICY_DEQUEUE( pxTCB )                                                 \
+    {                                                                                   \
+        if( uxListRemove( &( ( pxTCB )->xStateListItem ) ) == ( UBaseType_t ) 0 )       \
+        {                                                                               \
+            taskRESET_READY_PRIORITY( ( pxTCB )->uxPriority );                          \
+        }                                                                               \
+    }
+
+    #define taskPOLICY_SELECT_NEXT_TASK()           taskSELECT_HIGHEST_PRIORITY_TASK()
+
+    #define taskPOLICY_PREEMPTS( pxTCB )            ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+    #define taskPOLICY_PREEMPTS_OR_TIES( pxTCB )    ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority )
+
+    #define taskPOLICY_PREEMPTS_AT_TICK( pxTCB )            taskPOLICY_PREEMPTS( pxTCB )
+    #define taskPOLICY_PREEMPTS_OR_TIES_AT_TICK( pxTCB )    taskPOLICY_PREEMPTS_OR_TIES( pxTCB )
+
+/* Tasks of equal priority to the currently running task will share
+ * processing time (time slice) if preemption is on, and the application
+ * writer has not explicitly turned time slicing off. */
+    #if ( configUSE_TIME_SLICING == 1 )
+        #define taskPOLICY_TICK_PREEMPTS()    ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+    #else
+        #define taskPOLICY_TICK_PREEMPTS()    pdFALSE
+    #endif
+
+/* Event lists are sorted in ascending item value, so the value is the
+ * priority reversed. */
+    #define taskEVENT_LIST_ITEM_VALUE( pxTCB )    ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) ( pxTCB )->uxPriority ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+#endif /* configUSE_EDF_SCHEDULER */
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task, as decided by the scheduling policy.
  */
 // $$ Change #3
-#if (configUSE_EDF_SCHEDULER == 1)
-	#define prvAddTaskToReadyList( pxTCB )                                                               \
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );  \
-	vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )   										
-		
-#else
-		
-	#define prvAddTaskToReadyList( pxTCB )                                                              \
-	traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-	listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )	
-	
-#endif
-   
+#define prvAddTaskToReadyList( pxTCB )    \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB ); \
+    taskPOLICY_ENQUEUE_READY( pxTCB );       \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -280,7 +442,27 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     ListItem_t xStateListItem;                  /*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
     ListItem_t xEventListItem;                  /*< Used to reference a task from an event list. */
-    UBaseType_t uxPriority;                     /*< The priority of the task.  0 is the lowest priority. */
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+
+        /* Read every time the task is added to the ready list, so they are kept
+         * next to xStateListItem.  Tasks have no priority under EDF. */
+        TickType_t xTaskDeadline;         /*< Absolute deadline of the current job. */
+        TickType_t xTaskPeriod;           /*< Release period of the task, taskNON_PERIODIC if the task was not created with xTaskPeriodicCreate(). */
+        TickType_t xTaskRelativeDeadline; /*< Deadline of each job relative to its release.  Equal to the period unless set with vTaskSetPeriodicTiming(). */
+
+        #if ( taskPOLICY_USES_BUDGET == 1 )
+            TickType_t xTaskExecutionBudget; /*< Worst case execution time of a job, in ticks. */
+            TickType_t xTaskRemainingBudget; /*< Execution budget left to the current job. */
+        #endif
+
+        #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+            TickType_t xTaskBaseDeadline; /*< Deadline of the current job while xTaskDeadline holds one inherited from a message. */
+        #endif
+    #else
+        UBaseType_t uxPriority; /*< The priority of the task.  0 is the lowest priority. */
+    #endif
+
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
@@ -298,7 +480,9 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #endif
 
     #if ( configUSE_MUTEXES == 1 )
-        UBaseType_t uxBasePriority; /*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+        #if ( configUSE_EDF_SCHEDULER == 0 )
+            UBaseType_t uxBasePriority; /*< The priority last assigned to the task - used by the priority inheritance mechanism. */
+        #endif
         UBaseType_t uxMutexesHeld;
     #endif
 
@@ -312,6 +496,12 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
+
+        #if ( configRUN_TIME_WINDOWS > 0 )
+            configRUN_TIME_COUNTER_TYPE ulWindowRunTime[ configRUN_TIME_WINDOWS ];     /*< Time spent running in window uxRunTimeWindow of each length. */
+            configRUN_TIME_COUNTER_TYPE ulLastWindowRunTime[ configRUN_TIME_WINDOWS ]; /*< Time spent running in the window before it. */
+            UBaseType_t uxRunTimeWindow[ configRUN_TIME_WINDOWS ];                     /*< Number of the window the task was last charged in. */
+        #endif
     #endif
 
     #if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -344,13 +534,59 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         uint8_t ucDelayAborted;
     #endif
 
+    /* The byte wide EDF flags follow the ones above so they share the padding. */
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+            uint8_t ucZeroLaxity; /*< Set to pdTRUE once the laxity of the current job has reached zero. */
+        #endif
+
+        #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+            uint8_t ucDeadlineInherited; /*< Set to pdTRUE while xTaskDeadline holds an inherited deadline. */
+        #endif
+
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            uint8_t ucLetState; /*< One of the taskLET_ values. */
+        #endif
+
+        #if ( configUSE_JOB_STATS == 1 )
+            uint8_t ucJobStarted; /*< Set to pdTRUE once the current job has been switched in. */
+        #endif
+    #endif
+
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
 
+    #if ( configUSE_STACK_WATERMARKS == 1 )
+        configSTACK_DEPTH_TYPE uxStackDepth;   /*< Size of the stack in words. */
+        configSTACK_DEPTH_TYPE uxStackFree;    /*< Words at the far end of the stack still holding tskSTACK_FILL_WORD, as of the last complete pass of xTaskStackWatermarkStep(). */
+        configSTACK_DEPTH_TYPE uxStackScanned; /*< Words the current pass has checked, counting from the far end. */
+    #endif
+
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+        UBaseType_t uxCriticalDepth; /*< Critical section nesting the profiler saw when the task was last switched out. */
+        uint32_t ulCriticalSite;     /*< Call site of that outermost critical section, only valid while uxCriticalDepth is not 0. */
+    #endif
+
     //$$ Change 4
     #if (configUSE_EDF_SCHEDULER == 1)
-        TickType_t xTaskPeriod;
+        UBaseType_t uxDeadlineMisses; /*< Number of jobs that completed after their absolute deadline. */
+
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            TickType_t xLetRelease;                   /*< Release of the next job, when its inputs are latched. */
+            TickType_t xLetDeadline;                  /*< Deadline of the current job, when its outputs are committed. */
+            struct tskTaskControlBlock * pxNextLetTCB; /*< Next task in LET mode, only valid while ucLetState is not taskLET_OFF. */
+        #endif
+
+        #if ( configUSE_JOB_STATS == 1 )
+            uint32_t ulJobStartTime;                                                  /*< When the current job was first switched in, valid once ucJobStarted is pdTRUE. */
+            uint32_t ulLastStartLatency;                                              /*< Start time less release time of the last completed job. */
+            uint32_t ulLastResponseTime;                                              /*< Completion time less release time of the last completed job. */
+            UBaseType_t uxJobsCompleted;                                              /*< See TaskJobStats_t. */
+            UBaseType_t uxContextSwitches;                                            /*< See TaskJobStats_t. */
+            UBaseType_t uxPreemptions;                                                /*< See TaskJobStats_t. */
+            uint16_t usJobHistogram[ tskJOB_HISTOGRAMS ][ configJOB_STATS_BUCKETS ]; /*< See TaskJobStats_t. */
+        #endif
     #endif
 
 } tskTCB;
@@ -359,6 +595,15 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+/* Statically created tasks are handed a StaticTask_t to use as their TCB, so
+ * it must not be smaller than the TCB.  The array size below is negative, and
+ * the build fails, if it is. */
+    typedef char tskSTATIC_TCB_SIZE_CHECK[ ( sizeof( StaticTask_t ) >= sizeof( TCB_t ) ) ? 1 : -1 ];
+
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
@@ -376,7 +621,10 @@ PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
 by their deadline. */
 #endif
 
-PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+#if ( configUSE_EDF_SCHEDULER == 0 )
+    PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
+#endif
+
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
@@ -405,7 +653,9 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_EDF_SCHEDULER == 0 )
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
@@ -414,6 +664,15 @@ PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSCHEDULING_POLICY == schedPOLICY_EDZL ) )
+    PRIVILEGED_DATA static TickType_t xNextZeroLaxityTime = ( TickType_t ) configINITIAL_TICK_COUNT; /*< Earliest time at which a ready job that still has laxity will run out of it.  Starts at the first tick, so every task created before then is checked. */
+#endif
+
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+    PRIVILEGED_DATA static TCB_t * pxLetTasks = NULL;                 /*< Tasks in LET mode, linked through pxNextLetTCB. */
+    PRIVILEGED_DATA static TickType_t xNextLetInstant = portMAX_DELAY; /*< Next tick at which a LET task is released or reaches its deadline. */
+#endif
+
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
@@ -433,9 +692,38 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in, or the time was last charged anywhere when configUSE_CPU_ACCOUNTING is 1. */
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
+    #if ( configUSE_CPU_ACCOUNTING == 1 )
+
+/* Value of uxActiveISR outside interrupts. */
+        #define taskNO_ISR    ( ( UBaseType_t ) configACCOUNTING_ISRS )
+
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulISRRunTime[ configACCOUNTING_ISRS ]; /*< See TaskCpuAccounting_t. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulSchedulerRunTime = 0UL;              /*< See TaskCpuAccounting_t. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulSwitchRunTime = 0UL;                 /*< See TaskCpuAccounting_t. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulSchedulerStartTime = 0UL;            /*< Run time counter value when the scheduler started. */
+        PRIVILEGED_DATA static UBaseType_t uxContextSwitchCount = ( UBaseType_t ) 0U;            /*< See TaskCpuAccounting_t. */
+        PRIVILEGED_DATA static UBaseType_t uxActiveISR = taskNO_ISR;                             /*< Interrupt time is being charged to, taskNO_ISR when it is charged to a task. */
+    #endif
+
+    #if ( configRUN_TIME_WINDOWS > 0 )
+        PRIVILEGED_DATA static const TickType_t xRunTimeWindowTicks[ configRUN_TIME_WINDOWS ] = configRUN_TIME_WINDOW_TICKS;
+        PRIVILEGED_DATA static TickType_t xRunTimeWindowTicksLeft[ configRUN_TIME_WINDOWS ];                  /*< Ticks until each window ends. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulRunTimeWindowStart[ configRUN_TIME_WINDOWS ];  /*< Run time counter value when each window started. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulRunTimeWindowLength[ configRUN_TIME_WINDOWS ]; /*< Length of the last complete window of each length. */
+        PRIVILEGED_DATA static UBaseType_t uxRunTimeWindow[ configRUN_TIME_WINDOWS ];                       /*< Number of the current window of each length. */
+    #endif
+
+#endif
+
+#if ( configUSE_JOB_STATS == 1 )
+
+/* configJOB_STATS_TIMESTAMP() when the tick count last changed.  Release times
+ * and deadlines are converted from ticks relative to it. */
+    PRIVILEGED_DATA static uint32_t ulJobStatsTickTime = 0UL;
+
 #endif
 
 /*lint -restore */
@@ -590,6 +878,169 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Makes a task that has just been initialised periodic and releases its first
+ * job.  Must be called before the task is added to a ready list.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvInitialisePeriodicTiming( TCB_t * pxNewTCB,
+                                             TickType_t xPeriod,
+                                             TickType_t xRelativeDeadline,
+                                             TickType_t xExecutionBudget ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Creates a periodic task in caller supplied memory.  Shared by
+ * xTaskPeriodicCreateStatic() and xTaskPeriodicCreateTable().
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    static TaskHandle_t prvPeriodicCreateStatic( TaskFunction_t pxTaskCode,
+                                                 const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                 const uint32_t ulStackDepth,
+                                                 void * const pvParameters,
+                                                 UBaseType_t uxPriority,
+                                                 StackType_t * const puxStackBuffer,
+                                                 StaticTask_t * const pxTaskBuffer,
+                                                 TickType_t xPeriod,
+                                                 TickType_t xRelativeDeadline,
+                                                 TickType_t xExecutionBudget ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Reads the run time counter, through portALT_GET_RUN_TIME_COUNTER_VALUE() if
+ * the port defines it.
+ */
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Charges the time since ulTaskSwitchedInTime to the running task, then moves
+ * ulTaskSwitchedInTime to ulNow.
+ */
+    static void prvChargeCurrentTask( configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Charges the time since ulTaskSwitchedInTime to one of the buckets that are
+ * not a task, then moves ulTaskSwitchedInTime to the current time.
+ */
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+
+    static void prvChargeAccounting( configRUN_TIME_COUNTER_TYPE * pulBucket ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Charges the time pxTCB ran from ulSwitchedInTime to ulNow to each run time
+ * window, splitting it where a window ended.  Only needs the windows the
+ * task was last charged in, so the cost does not depend on how long ago that
+ * was.
+ */
+#if ( configRUN_TIME_WINDOWS > 0 )
+
+    static void prvChargeRunTimeWindows( TCB_t * pxTCB,
+                                         configRUN_TIME_COUNTER_TYPE ulSwitchedInTime,
+                                         configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt to end the windows whose length has passed.
+ */
+    static void prvRunTimeWindowsTick( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called when a periodic task completes a job by delaying until its next
+ * release.  Records a deadline miss if the job finished late, then sets the
+ * absolute deadline (and budget, when the policy uses one) of the next job.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvReleaseNextJob( TCB_t * pxTCB,
+                                   TickType_t xReleaseTime ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by prvReleaseNextJob() before the deadline of the completed job is
+ * overwritten, to add its timing to the histograms of pxTCB.
+ */
+#if ( configUSE_JOB_STATS == 1 )
+
+    static void prvJobStatsComplete( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds one value to a histogram, in the log2 bucket it falls in.
+ */
+    static void prvJobStatsAdd( TCB_t * pxTCB,
+                                eJobHistogram eHistogram,
+                                uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Gives pxTCB back the deadline of its current job if it inherited an earlier
+ * one from a message.  The caller re-sorts the ready list.
+ */
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+
+    static void prvRestoreBaseDeadline( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the tick interrupt when xTickCount reaches xNextLetInstant.
+ * Commits the outputs of every LET task whose deadline it is, then latches
+ * the inputs of every LET task released, so a job released at the deadline
+ * of another sees its outputs.
+ */
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+
+    static void prvLetTick( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Sets xNextLetInstant to the nearest release or deadline of a LET task that
+ * is still to come.  Must be called with interrupts masked.
+ */
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+
+    static void prvSetNextLetInstant( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Charges the tick to the execution budget of the running task and moves it
+ * down the ready list if another task now has less laxity.  Under EDZL also
+ * promotes the ready jobs whose laxity reached zero.  Returns pdTRUE if the
+ * running task should be preempted.  Called from the tick interrupt.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( taskPOLICY_USES_BUDGET == 1 ) )
+
+    static BaseType_t prvLaxityTickCheck( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Marks the current job of pxTCB as having zero laxity if it has none left,
+ * otherwise makes sure xNextZeroLaxityTime is not later than the time at
+ * which it will have none.  prvPromoteZeroLaxityTasks() applies the same check
+ * to every task in the ready list.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSCHEDULING_POLICY == schedPOLICY_EDZL ) )
+
+    static void prvCheckZeroLaxity( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvPromoteZeroLaxityTasks( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -721,7 +1172,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             /* Allocate space for the TCB.  Where the memory comes from depends
              * on the implementation of the port malloc function and whether or
              * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            pxNewTCB = taskMALLOC_TCB();
 
             if( pxNewTCB != NULL )
             {
@@ -776,7 +1227,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* Allocate space for the TCB.  Where the memory comes from depends on
                  * the implementation of the port malloc function and whether or not static
                  * allocation is being used. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = taskMALLOC_TCB();
 
                 if( pxNewTCB != NULL )
                 {
@@ -788,7 +1239,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                     if( pxNewTCB->pxStack == NULL )
                     {
                         /* Could not allocate the stack.  Delete the allocated TCB. */
-                        vPortFree( pxNewTCB );
+                        taskFREE_TCB( pxNewTCB );
                         pxNewTCB = NULL;
                     }
                 }
@@ -803,7 +1254,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxStack != NULL )
                 {
                     /* Allocate space for the TCB. */
-                    pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                    pxNewTCB = taskMALLOC_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                     if( pxNewTCB != NULL )
                     {
@@ -851,7 +1302,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 
 
-#if ( configUSE_EDF_SCHEDULER == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
     BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
                             const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -872,7 +1323,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* Allocate space for the TCB.  Where the memory comes from depends on
                  * the implementation of the port malloc function and whether or not static
                  * allocation is being used. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = taskMALLOC_TCB();
 
                 if( pxNewTCB != NULL )
                 {
@@ -884,7 +1335,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                     if( pxNewTCB->pxStack == NULL )
                     {
                         /* Could not allocate the stack.  Delete the allocated TCB. */
-                        vPortFree( pxNewTCB );
+                        taskFREE_TCB( pxNewTCB );
                         pxNewTCB = NULL;
                     }
                 }
@@ -899,7 +1350,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 if( pxStack != NULL )
                 {
                     /* Allocate space for the TCB. */
-                    pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                    pxNewTCB = taskMALLOC_TCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                     if( pxNewTCB != NULL )
                     {
@@ -932,10 +1383,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            pxNewTCB->xTaskPeriod = period;
-					
-						listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ), (pxNewTCB)->xTaskPeriod + xTaskGetTickCount());
             prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+
+            /* The deadline of each job is one period after its release. */
+            prvInitialisePeriodicTiming( pxNewTCB, period, period, ( TickType_t ) 0U );
+
             prvAddNewTaskToReadyList( pxNewTCB );
             xReturn = pdPASS;
         }
@@ -950,42 +1402,896 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                  const uint32_t ulStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask,
-                                  TCB_t * pxNewTCB,
-                                  const MemoryRegion_t * const xRegions )
-{
-    StackType_t * pxTopOfStack;
-    UBaseType_t x;
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    static TaskHandle_t prvPeriodicCreateStatic( TaskFunction_t pxTaskCode,
+                                                 const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                 const uint32_t ulStackDepth,
+                                                 void * const pvParameters,
+                                                 UBaseType_t uxPriority,
+                                                 StackType_t * const puxStackBuffer,
+                                                 StaticTask_t * const pxTaskBuffer,
+                                                 TickType_t xPeriod,
+                                                 TickType_t xRelativeDeadline,
+                                                 TickType_t xExecutionBudget )
+    {
+        TCB_t * pxNewTCB;
+        TaskHandle_t xReturn;
 
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-        /* Should the task be created in privileged mode? */
-        BaseType_t xRunPrivileged;
+        configASSERT( puxStackBuffer != NULL );
+        configASSERT( pxTaskBuffer != NULL );
 
-        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+        #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticTask_t equals the size of the real task
+                 * structure. */
+                volatile size_t xSize = sizeof( StaticTask_t );
+                configASSERT( xSize == sizeof( TCB_t ) );
+                ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+            }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
         {
-            xRunPrivileged = pdTRUE;
+            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+                {
+                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
+            prvInitialisePeriodicTiming( pxNewTCB, xPeriod, xRelativeDeadline, xExecutionBudget );
+            prvAddNewTaskToReadyList( pxNewTCB );
         }
         else
         {
-            xRunPrivileged = pdFALSE;
+            xReturn = NULL;
         }
-        uxPriority &= ~portPRIVILEGE_BIT;
-    #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-    /* Avoid dependency on memset() if it is not required. */
-    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
-        {
-            /* Fill the stack with a known value to assist debugging. */
-            ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
-        }
-    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-    /* Calculate the top of stack address.  This depends on whether the stack
+    TaskHandle_t xTaskPeriodicCreateStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            const uint32_t ulStackDepth,
+                                            void * const pvParameters,
+                                            UBaseType_t uxPriority,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer,
+                                            TickType_t xPeriod )
+    {
+        return prvPeriodicCreateStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, xPeriod, xPeriod, ( TickType_t ) 0U );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPeriodicCreateTable( const PeriodicTaskParameters_t * const pxTaskTable,
+                                         UBaseType_t uxNumberOfTasks )
+    {
+        const PeriodicTaskParameters_t * pxEntry;
+        TaskHandle_t xHandle;
+        UBaseType_t uxIndex;
+        BaseType_t xReturn = pdPASS;
+
+        configASSERT( pxTaskTable != NULL );
+
+        /* The first jobs are all released at the same instant, which only holds
+         * while the tick count is not moving. */
+        configASSERT( xSchedulerRunning == pdFALSE );
+
+        for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxNumberOfTasks; uxIndex++ )
+        {
+            pxEntry = &( pxTaskTable[ uxIndex ] );
+
+            xHandle = prvPeriodicCreateStatic( pxEntry->pvTaskCode,
+                                               pxEntry->pcName,
+                                               ( uint32_t ) pxEntry->usStackDepth,
+                                               pxEntry->pvParameters,
+                                               tskIDLE_PRIORITY,
+                                               pxEntry->puxStackBuffer,
+                                               pxEntry->pxTaskBuffer,
+                                               pxEntry->xPeriod,
+                                               pxEntry->xRelativeDeadline,
+                                               pxEntry->xExecutionBudget );
+
+            if( pxEntry->pxCreatedTask != NULL )
+            {
+                *( pxEntry->pxCreatedTask ) = xHandle;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xHandle == NULL )
+            {
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvInitialisePeriodicTiming( TCB_t * pxNewTCB,
+                                             TickType_t xPeriod,
+                                             TickType_t xRelativeDeadline,
+                                             TickType_t xExecutionBudget )
+    {
+        configASSERT( xPeriod != taskNON_PERIODIC );
+        configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+
+        /* The first job is released now. */
+        pxNewTCB->xTaskPeriod = xPeriod;
+        pxNewTCB->xTaskRelativeDeadline = xRelativeDeadline;
+        pxNewTCB->xTaskDeadline = xTaskGetTickCount() + xRelativeDeadline;
+
+        #if ( taskPOLICY_USES_BUDGET == 1 )
+            {
+                pxNewTCB->xTaskExecutionBudget = xExecutionBudget;
+                pxNewTCB->xTaskRemainingBudget = xExecutionBudget;
+            }
+        #else
+            {
+                ( void ) xExecutionBudget;
+            }
+        #endif
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    void vTaskSetPeriodicTiming( TaskHandle_t xTask,
+                                 TickType_t xRelativeDeadline,
+                                 TickType_t xExecutionBudget )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB->xTaskPeriod != taskNON_PERIODIC );
+
+            #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+                {
+                    prvRestoreBaseDeadline( pxTCB );
+                }
+            #endif
+
+            /* Keep the deadline of the current job relative to its release. */
+            pxTCB->xTaskDeadline = ( pxTCB->xTaskDeadline - pxTCB->xTaskRelativeDeadline ) + xRelativeDeadline;
+            pxTCB->xTaskRelativeDeadline = xRelativeDeadline;
+            traceTASK_DEADLINE_SET( pxTCB );
+
+            #if ( taskPOLICY_USES_BUDGET == 1 )
+                {
+                    pxTCB->xTaskExecutionBudget = xExecutionBudget;
+                    pxTCB->xTaskRemainingBudget = xExecutionBudget;
+                }
+            #else
+                {
+                    ( void ) xExecutionBudget;
+                }
+            #endif
+
+            /* The key of the task may have changed, so re-sort it if it is
+             * ready. */
+            if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                taskPOLICY_DEQUEUE( pxTCB );
+                prvAddTaskToReadyList( pxTCB );
+
+                if( xSchedulerRunning == pdFALSE )
+                {
+                    /* Start the scheduler with the task at the head of the
+                     * ready list. */
+                    taskPOLICY_SELECT_NEXT_TASK();
+                }
+                else if( listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ) != pxCurrentTCB )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            taskYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    UBaseType_t uxTaskGetDeadlineMisses( TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxDeadlineMisses;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_JOB_STATS == 1 )
+
+    static void prvJobStatsComplete( TCB_t * pxTCB )
+    {
+        uint32_t ulNow, ulRelease, ulDeadline, ulStartLatency, ulResponseTime;
+
+        ulNow = configJOB_STATS_TIMESTAMP();
+
+        /* The release of the job is a tick no later than the current one, its
+         * deadline is relative to it.  The inherited deadline, if any, was
+         * already given back. */
+        ulRelease = ulJobStatsTickTime - configJOB_STATS_TICKS_TO_TIMESTAMP( xTickCount - ( pxTCB->xTaskDeadline - pxTCB->xTaskRelativeDeadline ) );
+        ulDeadline = ulRelease + configJOB_STATS_TICKS_TO_TIMESTAMP( pxTCB->xTaskRelativeDeadline );
+
+        ulResponseTime = ulNow - ulRelease;
+        ulStartLatency = pxTCB->ulJobStartTime - ulRelease;
+
+        prvJobStatsAdd( pxTCB, eJobResponseTime, ulResponseTime );
+
+        if( ( int32_t ) ( ulNow - ulDeadline ) > 0 )
+        {
+            prvJobStatsAdd( pxTCB, eJobLateness, ulNow - ulDeadline );
+        }
+        else
+        {
+            prvJobStatsAdd( pxTCB, eJobLateness, 0UL );
+        }
+
+        /* Jitter is the change from one job to the next. */
+        if( pxTCB->uxJobsCompleted > ( UBaseType_t ) 0U )
+        {
+            prvJobStatsAdd( pxTCB, eJobStartJitter, ( ulStartLatency > pxTCB->ulLastStartLatency ) ? ( ulStartLatency - pxTCB->ulLastStartLatency ) : ( pxTCB->ulLastStartLatency - ulStartLatency ) );
+            prvJobStatsAdd( pxTCB, eJobFinishJitter, ( ulResponseTime > pxTCB->ulLastResponseTime ) ? ( ulResponseTime - pxTCB->ulLastResponseTime ) : ( pxTCB->ulLastResponseTime - ulResponseTime ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->ulLastStartLatency = ulStartLatency;
+        pxTCB->ulLastResponseTime = ulResponseTime;
+        ( pxTCB->uxJobsCompleted )++;
+
+        /* The next job starts when the task is next switched in. */
+        pxTCB->ucJobStarted = pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvJobStatsAdd( TCB_t * pxTCB,
+                                eJobHistogram eHistogram,
+                                uint32_t ulValue )
+    {
+        UBaseType_t uxBucket = ( UBaseType_t ) 0U;
+
+        /* No count leading zeros instruction is assumed, values are small. */
+        while( ( ulValue != 0UL ) && ( uxBucket < ( UBaseType_t ) ( configJOB_STATS_BUCKETS - 1 ) ) )
+        {
+            ulValue >>= 1;
+            uxBucket++;
+        }
+
+        if( pxTCB->usJobHistogram[ eHistogram ][ uxBucket ] < ( uint16_t ) 0xFFFFU )
+        {
+            ( pxTCB->usJobHistogram[ eHistogram ][ uxBucket ] )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetJobStats( TaskHandle_t xTask,
+                           TaskJobStats_t * pxStats )
+    {
+        TCB_t const * pxTCB;
+
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxStats->uxJobs = pxTCB->uxJobsCompleted;
+            pxStats->uxContextSwitches = pxTCB->uxContextSwitches;
+            pxStats->uxPreemptions = pxTCB->uxPreemptions;
+            ( void ) memcpy( ( void * ) &( pxStats->usHistogram[ 0 ][ 0 ] ), ( const void * ) &( pxTCB->usJobHistogram[ 0 ][ 0 ] ), sizeof( pxStats->usHistogram ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskClearJobStats( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->uxJobsCompleted = ( UBaseType_t ) 0U;
+            pxTCB->uxContextSwitches = ( UBaseType_t ) 0U;
+            pxTCB->uxPreemptions = ( UBaseType_t ) 0U;
+            ( void ) memset( ( void * ) &( pxTCB->usJobHistogram[ 0 ][ 0 ] ), 0x00, sizeof( pxTCB->usJobHistogram ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_JOB_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+    static void prvReleaseNextJob( TCB_t * pxTCB,
+                                   TickType_t xReleaseTime )
+    {
+        #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+            {
+                /* An inherited deadline only lasts until the end of the job
+                 * that received the message.  Periodic tasks are re-sorted
+                 * below, a background task that did not need to delay keeps
+                 * its place in the ready list until it next blocks. */
+                prvRestoreBaseDeadline( pxTCB );
+            }
+        #endif
+
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            {
+                if( pxTCB->ucLetState == taskLET_LATCH_PENDING )
+                {
+                    /* The job overran the next release, which has already
+                     * happened, so the next job starts now with fresh
+                     * inputs.  The outputs of the late job are not committed. */
+                    vLetLatchInputs( pxTCB );
+                    pxTCB->ucLetState = taskLET_JOB_RUNNING;
+                }
+                else if( pxTCB->ucLetState == taskLET_JOB_RUNNING )
+                {
+                    pxTCB->ucLetState = taskLET_JOB_DONE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        if( pxTCB->xTaskPeriod != taskNON_PERIODIC )
+        {
+            if( taskDEADLINE_BEFORE( pxTCB->xTaskDeadline, xTickCount ) )
+            {
+                ( pxTCB->uxDeadlineMisses )++;
+                traceTASK_DEADLINE_MISSED( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_JOB_STATS == 1 )
+                {
+                    prvJobStatsComplete( pxTCB );
+                }
+            #endif
+
+            pxTCB->xTaskDeadline = xReleaseTime + pxTCB->xTaskRelativeDeadline;
+            traceTASK_DEADLINE_SET( pxTCB );
+
+            #if ( taskPOLICY_USES_BUDGET == 1 )
+                {
+                    pxTCB->xTaskRemainingBudget = pxTCB->xTaskExecutionBudget;
+                }
+            #endif
+
+            #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+                {
+                    pxTCB->ucZeroLaxity = pdFALSE;
+                }
+            #endif
+
+            /* A task that did not need to delay is still in the ready list,
+             * re-sort it on the key of its new job.  This is only ever called
+             * with the scheduler suspended so interrupts do not access the
+             * ready list. */
+            if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE )
+            {
+                taskPOLICY_DEQUEUE( pxTCB );
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configUSE_JOB_STATS == 1 )
+                    {
+                        /* The job released already and the task is still
+                         * running, so it has started too. */
+                        pxTCB->ulJobStartTime = configJOB_STATS_TIMESTAMP();
+                        pxTCB->ucJobStarted = pdTRUE;
+                    }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_EDF_SCHEDULER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+
+    static void prvRestoreBaseDeadline( TCB_t * pxTCB )
+    {
+        if( pxTCB->ucDeadlineInherited != pdFALSE )
+        {
+            traceTASK_DEADLINE_RESTORE( pxTCB );
+            pxTCB->xTaskDeadline = pxTCB->xTaskBaseDeadline;
+            pxTCB->ucDeadlineInherited = pdFALSE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_DEADLINE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+
+    void vTaskDeadlineInherit( TaskHandle_t const xTask,
+                               TickType_t xDeadline )
+    {
+        TCB_t * const pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Only ever moves the deadline earlier, so a task serving several
+         * messages runs with the earliest of their deadlines. */
+        if( taskDEADLINE_BEFORE( xDeadline, pxTCB->xTaskDeadline ) )
+        {
+            traceTASK_DEADLINE_INHERIT( pxTCB, xDeadline );
+
+            if( pxTCB->ucDeadlineInherited == pdFALSE )
+            {
+                pxTCB->xTaskBaseDeadline = pxTCB->xTaskDeadline;
+                pxTCB->ucDeadlineInherited = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->xTaskDeadline = xDeadline;
+
+            /* A blocked task picks up the new key when it is readied.  A ready
+             * task is re-sorted now, unless the scheduler is suspended, in
+             * which case the task that suspended it may itself be half way
+             * through moving between lists. */
+            if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) &&
+                ( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                taskPOLICY_DEQUEUE( pxTCB );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_DEADLINE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_INHERITANCE == 1 )
+
+    void vTaskRestoreDeadline( void )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( pxCurrentTCB->ucDeadlineInherited != pdFALSE )
+            {
+                prvRestoreBaseDeadline( pxCurrentTCB );
+                taskPOLICY_DEQUEUE( pxCurrentTCB );
+                prvAddTaskToReadyList( pxCurrentTCB );
+
+                if( listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ) != pxCurrentTCB )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            taskYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_DEADLINE_INHERITANCE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+
+    static void prvSetNextLetInstant( const TickType_t xConstTickCount )
+    {
+        TCB_t * pxTCB;
+        TickType_t xNearest = portMAX_DELAY, xToRelease, xToDeadline;
+
+        /* Every release is in the future, a deadline only counts until it has
+         * been reached. */
+        for( pxTCB = pxLetTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextLetTCB )
+        {
+            xToRelease = pxTCB->xLetRelease - xConstTickCount;
+            xToDeadline = pxTCB->xLetDeadline - xConstTickCount;
+
+            if( ( xToDeadline != ( TickType_t ) 0U ) && ( xToDeadline < xToRelease ) )
+            {
+                xToRelease = xToDeadline;
+            }
+
+            if( xToRelease < xNearest )
+            {
+                xNearest = xToRelease;
+            }
+        }
+
+        xNextLetInstant = xConstTickCount + xNearest;
+    }
+
+    static void prvLetTick( TickType_t xConstTickCount )
+    {
+        TCB_t * pxTCB;
+
+        for( pxTCB = pxLetTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextLetTCB )
+        {
+            if( pxTCB->xLetDeadline == xConstTickCount )
+            {
+                if( pxTCB->ucLetState == taskLET_JOB_DONE )
+                {
+                    vLetCommitOutputs( pxTCB );
+                }
+                else
+                {
+                    /* The outputs of the last job that completed in time
+                     * stay in place. */
+                    traceTASK_LET_OVERRUN( pxTCB );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        for( pxTCB = pxLetTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextLetTCB )
+        {
+            if( pxTCB->xLetRelease == xConstTickCount )
+            {
+                if( pxTCB->ucLetState == taskLET_JOB_DONE )
+                {
+                    vLetLatchInputs( pxTCB );
+                    pxTCB->ucLetState = taskLET_JOB_RUNNING;
+                }
+                else
+                {
+                    pxTCB->ucLetState = taskLET_LATCH_PENDING;
+                }
+
+                pxTCB->xLetDeadline = xConstTickCount + pxTCB->xTaskRelativeDeadline;
+                pxTCB->xLetRelease = xConstTickCount + pxTCB->xTaskPeriod;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        prvSetNextLetInstant( xConstTickCount );
+    }
+
+#endif /* configUSE_LOGICAL_EXECUTION_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+
+    void vTaskSetLogicalExecution( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TickType_t xJobDeadline;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB->xTaskPeriod != taskNON_PERIODIC );
+            configASSERT( pxTCB->xTaskRelativeDeadline <= pxTCB->xTaskPeriod );
+            configASSERT( pxTCB->ucLetState == taskLET_OFF );
+
+            xJobDeadline = pxTCB->xTaskDeadline;
+
+            #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+                {
+                    if( pxTCB->ucDeadlineInherited != pdFALSE )
+                    {
+                        xJobDeadline = pxTCB->xTaskBaseDeadline;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
+            /* The current job runs on the inputs committed so far and is
+             * committed at its own deadline. */
+            pxTCB->xLetDeadline = xJobDeadline;
+            pxTCB->xLetRelease = ( xJobDeadline - pxTCB->xTaskRelativeDeadline ) + pxTCB->xTaskPeriod;
+            pxTCB->ucLetState = taskLET_JOB_RUNNING;
+            vLetLatchInputs( pxTCB );
+
+            pxTCB->pxNextLetTCB = pxLetTasks;
+            pxLetTasks = pxTCB;
+            prvSetNextLetInstant( xTickCount );
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_LOGICAL_EXECUTION_TIME */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( taskPOLICY_USES_BUDGET == 1 ) )
+
+    static BaseType_t prvLaxityTickCheck( void )
+    {
+        TCB_t * pxHeadTCB;
+
+        /* The running task may be on its way to the Blocked state if the tick
+         * is being unwound by xTaskResumeAll(). */
+        if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+        {
+            if( pxCurrentTCB->xTaskRemainingBudget > ( TickType_t ) 0U )
+            {
+                ( pxCurrentTCB->xTaskRemainingBudget )--;
+
+                /* The laxity of every waiting task dropped by one tick while
+                 * that of the running task did not, which shows up as the LLF
+                 * key of the running task growing by one.  Move it behind any
+                 * task that now sorts strictly before it. */
+                if( listGET_LIST_ITEM_VALUE( listGET_NEXT( &( pxCurrentTCB->xStateListItem ) ) ) < taskPOLICY_KEY( pxCurrentTCB ) )
+                {
+                    taskPOLICY_DEQUEUE( pxCurrentTCB );
+                    prvAddTaskToReadyList( pxCurrentTCB );
+                }
+                else
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), taskPOLICY_KEY( pxCurrentTCB ) );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+            {
+                if( taskDEADLINE_BEFORE( xTickCount, xNextZeroLaxityTime ) == pdFALSE )
+                {
+                    prvPromoteZeroLaxityTasks();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        /* The head of the ready list may have less laxity than the running
+         * task without being far enough ahead to preempt it. */
+        pxHeadTCB = listGET_OWNER_OF_HEAD_ENTRY( &xReadyTasksListEDF ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+        return ( ( pxHeadTCB != pxCurrentTCB ) && ( taskPOLICY_PREEMPTS_AT_TICK( pxHeadTCB ) ) ) ? pdTRUE : pdFALSE;
+    }
+
+#endif /* taskPOLICY_USES_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configSCHEDULING_POLICY == schedPOLICY_EDZL ) )
+
+    static void prvCheckZeroLaxity( TCB_t * pxTCB )
+    {
+        TickType_t xZeroLaxityTime;
+
+        if( ( pxTCB->xTaskPeriod != taskNON_PERIODIC ) && ( pxTCB->ucZeroLaxity == pdFALSE ) )
+        {
+            /* The job has no laxity left once the time to its deadline is no
+             * longer than the execution time it still needs. */
+            xZeroLaxityTime = pxTCB->xTaskDeadline - pxTCB->xTaskRemainingBudget;
+
+            if( taskDEADLINE_BEFORE( xTickCount, xZeroLaxityTime ) == pdFALSE )
+            {
+                pxTCB->ucZeroLaxity = pdTRUE;
+            }
+            else if( taskDEADLINE_BEFORE( xZeroLaxityTime, xNextZeroLaxityTime ) )
+            {
+                xNextZeroLaxityTime = xZeroLaxityTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPromoteZeroLaxityTasks( void )
+    {
+        ListItem_t * pxIterator;
+        ListItem_t * pxNext;
+        TCB_t * pxTCB;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( &xReadyTasksListEDF );
+
+        /* Recomputed from the jobs that keep their laxity, starting from the
+         * furthest time the modulo comparison can tell is still to come.  If
+         * none comes earlier, the promotion just runs again then. */
+        xNextZeroLaxityTime = xTickCount + ( portMAX_DELAY >> 1 );
+
+        for( pxIterator = listGET_HEAD_ENTRY( &xReadyTasksListEDF ); pxIterator != pxEndMarker; pxIterator = pxNext )
+        {
+            pxNext = listGET_NEXT( pxIterator );
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( pxTCB->ucZeroLaxity == pdFALSE )
+            {
+                prvCheckZeroLaxity( pxTCB );
+
+                if( pxTCB->ucZeroLaxity != pdFALSE )
+                {
+                    /* The new key is not later than the tick count, so the
+                     * task moves ahead of every job that still has laxity and
+                     * pxNext is left valid. */
+                    taskPOLICY_DEQUEUE( pxTCB );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* configSCHEDULING_POLICY == schedPOLICY_EDZL */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  const uint32_t ulStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask,
+                                  TCB_t * pxNewTCB,
+                                  const MemoryRegion_t * const xRegions )
+{
+    StackType_t * pxTopOfStack;
+    UBaseType_t x;
+
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        /* Should the task be created in privileged mode? */
+        BaseType_t xRunPrivileged;
+
+        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+        {
+            xRunPrivileged = pdTRUE;
+        }
+        else
+        {
+            xRunPrivileged = pdFALSE;
+        }
+        uxPriority &= ~portPRIVILEGE_BIT;
+    #endif /* portUSING_MPU_WRAPPERS == 1 */
+
+    /* Avoid dependency on memset() if it is not required. */
+    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
+        {
+            /* Fill the stack with a known value to assist debugging. */
+            ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+        }
+    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
+
+    #if ( configUSE_STACK_WATERMARKS == 1 )
+        {
+            /* Nothing is known to be free until the first pass completes. */
+            pxNewTCB->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+            pxNewTCB->uxStackFree = ( configSTACK_DEPTH_TYPE ) ulStackDepth;
+            pxNewTCB->uxStackScanned = ( configSTACK_DEPTH_TYPE ) 0;
+        }
+    #endif
+
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+        {
+            pxNewTCB->uxCriticalDepth = ( UBaseType_t ) 0U;
+            pxNewTCB->ulCriticalSite = 0UL;
+        }
+    #endif
+
+    /* Calculate the top of stack address.  This depends on whether the stack
      * grows from high memory to low (as per the 80x86) or vice versa.
      * portSTACK_GROWTH is used to make the result positive or negative as required
      * by the port. */
@@ -1049,22 +2355,35 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         pxNewTCB->pcTaskName[ 0 ] = 0x00;
     }
 
-    /* This is used as an array index so must ensure it's not too large. */
-    configASSERT( uxPriority < configMAX_PRIORITIES );
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* The scheduling policy decides where the task goes in the ready
+             * list, the priority is not kept. */
+            ( void ) uxPriority;
+        }
+    #else
+        {
+            /* This is used as an array index so must ensure it's not too large. */
+            configASSERT( uxPriority < configMAX_PRIORITIES );
 
-    if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
-    {
-        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+            if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+            {
+                uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxNewTCB->uxPriority = uxPriority;
+        }
+    #endif /* configUSE_EDF_SCHEDULER */
 
-    pxNewTCB->uxPriority = uxPriority;
     #if ( configUSE_MUTEXES == 1 )
         {
-            pxNewTCB->uxBasePriority = uxPriority;
+            #if ( configUSE_EDF_SCHEDULER == 0 )
+                pxNewTCB->uxBasePriority = uxPriority;
+            #endif
             pxNewTCB->uxMutexesHeld = 0;
         }
     #endif /* configUSE_MUTEXES */
@@ -1076,8 +2395,9 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
      * back to  the containing TCB from a generic item in a list. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
-    /* Event lists are always in priority order. */
-    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    /* Event lists are always in priority order, or in the order the tasks
+     * blocked under EDF. */
+    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), taskEVENT_LIST_ITEM_VALUE( pxNewTCB ) );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
     #if ( portCRITICAL_NESTING_IN_TCB == 1 )
@@ -1095,6 +2415,19 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         {
             pxNewTCB->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+
+            #if ( configRUN_TIME_WINDOWS > 0 )
+                {
+                    UBaseType_t x;
+
+                    for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configRUN_TIME_WINDOWS; x++ )
+                    {
+                        pxNewTCB->ulWindowRunTime[ x ] = ( configRUN_TIME_COUNTER_TYPE ) 0;
+                        pxNewTCB->ulLastWindowRunTime[ x ] = ( configRUN_TIME_COUNTER_TYPE ) 0;
+                        pxNewTCB->uxRunTimeWindow[ x ] = uxRunTimeWindow[ x ];
+                    }
+                }
+            #endif
         }
     #endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -1122,20 +2455,71 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         }
     #endif
 
-    #if ( configUSE_NEWLIB_REENTRANT == 1 )
-        {
-            /* Initialise this task's Newlib reent structure.
-             * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-             * for additional information. */
-            _REENT_INIT_PTR( ( &( pxNewTCB->xNewLib_reent ) ) );
-        }
-    #endif
+    #if ( configUSE_NEWLIB_REENTRANT == 1 )
+        {
+            /* Initialise this task's Newlib reent structure.
+             * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+             * for additional information. */
+            _REENT_INIT_PTR( ( &( pxNewTCB->xNewLib_reent ) ) );
+        }
+    #endif
+
+    #if ( INCLUDE_xTaskAbortDelay == 1 )
+        {
+            pxNewTCB->ucDelayAborted = pdFALSE;
+        }
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* Tasks are background tasks until xTaskPeriodicCreate() gives
+             * them a period. */
+            pxNewTCB->xTaskPeriod = taskNON_PERIODIC;
+            pxNewTCB->xTaskRelativeDeadline = taskNON_PERIODIC;
+            pxNewTCB->xTaskDeadline = taskNON_PERIODIC;
+            pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+
+            #if ( configUSE_DEADLINE_INHERITANCE == 1 )
+                {
+                    pxNewTCB->xTaskBaseDeadline = taskNON_PERIODIC;
+                    pxNewTCB->ucDeadlineInherited = pdFALSE;
+                }
+            #endif
+
+            #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+                {
+                    pxNewTCB->pxNextLetTCB = NULL;
+                    pxNewTCB->ucLetState = taskLET_OFF;
+                }
+            #endif
+
+            #if ( configUSE_JOB_STATS == 1 )
+                {
+                    pxNewTCB->ulJobStartTime = 0UL;
+                    pxNewTCB->ulLastStartLatency = 0UL;
+                    pxNewTCB->ulLastResponseTime = 0UL;
+                    pxNewTCB->uxJobsCompleted = ( UBaseType_t ) 0U;
+                    pxNewTCB->uxContextSwitches = ( UBaseType_t ) 0U;
+                    pxNewTCB->uxPreemptions = ( UBaseType_t ) 0U;
+                    memset( ( void * ) &( pxNewTCB->usJobHistogram[ 0 ][ 0 ] ), 0x00, sizeof( pxNewTCB->usJobHistogram ) );
+                    pxNewTCB->ucJobStarted = pdFALSE;
+                }
+            #endif
+
+            #if ( taskPOLICY_USES_BUDGET == 1 )
+                {
+                    pxNewTCB->xTaskExecutionBudget = ( TickType_t ) 0U;
+                    pxNewTCB->xTaskRemainingBudget = ( TickType_t ) 0U;
+                }
+            #endif
 
-    #if ( INCLUDE_xTaskAbortDelay == 1 )
-        {
-            pxNewTCB->ucDelayAborted = pdFALSE;
+            #if ( configSCHEDULING_POLICY == schedPOLICY_EDZL )
+                {
+                    pxNewTCB->ucZeroLaxity = pdFALSE;
+                }
+            #endif
         }
-    #endif
+    #endif /* configUSE_EDF_SCHEDULER */
 
     /* Initialize the TCB stack to look as if the task was already running,
      * but had been interrupted by the scheduler.  The return address is set
@@ -1235,7 +2619,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * so far. */
             if( xSchedulerRunning == pdFALSE )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                if( taskPOLICY_PREEMPTS_OR_TIES( pxNewTCB ) )
                 {
                     pxCurrentTCB = pxNewTCB;
                 }
@@ -1270,7 +2654,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( taskPOLICY_PREEMPTS( pxNewTCB ) )
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1299,14 +2683,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
             /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-            {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            taskPOLICY_DEQUEUE( pxTCB );
 
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
@@ -1318,6 +2695,26 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+                {
+                    if( pxTCB->ucLetState != taskLET_OFF )
+                    {
+                        TCB_t ** ppxLink = &pxLetTasks;
+
+                        while( *ppxLink != pxTCB )
+                        {
+                            ppxLink = &( ( *ppxLink )->pxNextLetTCB );
+                        }
+
+                        *ppxLink = pxTCB->pxNextLetTCB;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1455,6 +2852,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The job of the calling task is complete, the next one is
+                     * released at the wake time. */
+                    prvReleaseNextJob( pxCurrentTCB, xTimeToWake );
+                }
+            #endif
         }
         xAlreadyYielded = xTaskResumeAll();
 
@@ -1497,6 +2902,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * This task cannot be in an event list as it is the currently
                  * executing task. */
                 prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        prvReleaseNextJob( pxCurrentTCB, xTickCount + xTicksToDelay );
+                    }
+                #endif
             }
             xAlreadyYielded = xTaskResumeAll();
         }
@@ -1861,14 +3272,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-            {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            taskPOLICY_DEQUEUE( pxTCB );
 
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
@@ -2022,7 +3426,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( taskPOLICY_PREEMPTS_OR_TIES( pxTCB ) )
                     {
                         /* This yield may not cause the task just resumed to run,
                          * but will leave the lists in the correct state for the
@@ -2090,7 +3494,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 {
                     /* Ready lists can be accessed so move the task from the
                      * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( taskPOLICY_PREEMPTS_OR_TIES( pxTCB ) )
                     {
                         xYieldRequired = pdTRUE;
 
@@ -2161,26 +3565,16 @@ void vTaskStartScheduler( void )
         }
     #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
         {
-            #if (configUSE_EDF_SCHEDULER ==1)
-            
-            TickType_t initIDLEPeriod = 100;
-            xReturn = xTaskPeriodicCreate( prvIdleTask,
-                                   configIDLE_TASK_NAME,
-                                   configMINIMAL_STACK_SIZE,
-                                   ( void * ) NULL,
-                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                   &xIdleTaskHandle, initIDLEPeriod); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-
-            #else
-            /* The Idle task is being created using dynamically allocated RAM. */
+            /* The Idle task is being created using dynamically allocated RAM.
+             * When configUSE_EDF_SCHEDULER is 1 it is created as a non periodic
+             * task, so the scheduling policy always keeps it behind the
+             * periodic tasks. */
             xReturn = xTaskCreate( prvIdleTask,
                                    configIDLE_TASK_NAME,
                                    configMINIMAL_STACK_SIZE,
                                    ( void * ) NULL,
                                    portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
                                    &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-            #endif
-
         }
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 
@@ -2229,6 +3623,17 @@ void vTaskStartScheduler( void )
         xSchedulerRunning = pdTRUE;
         xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 
+        #if ( configUSE_JOB_STATS == 1 )
+            {
+                /* The first task is switched in without going through
+                 * vTaskSwitchContext(). */
+                ulJobStatsTickTime = configJOB_STATS_TIMESTAMP();
+                pxCurrentTCB->ulJobStartTime = ulJobStatsTickTime;
+                pxCurrentTCB->ucJobStarted = pdTRUE;
+                ( pxCurrentTCB->uxContextSwitches )++;
+            }
+        #endif
+
         /* If configGENERATE_RUN_TIME_STATS is defined then the following
          * macro must be defined to configure the timer/counter used to generate
          * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
@@ -2237,6 +3642,32 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                /* Only time from here on is charged to the tasks. */
+                ulTaskSwitchedInTime = prvGetRunTimeCounterValue();
+
+                #if ( configUSE_CPU_ACCOUNTING == 1 )
+                    {
+                        ulSchedulerStartTime = ulTaskSwitchedInTime;
+                    }
+                #endif
+
+                #if ( configRUN_TIME_WINDOWS > 0 )
+                    {
+                        UBaseType_t x;
+
+                        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configRUN_TIME_WINDOWS; x++ )
+                        {
+                            configASSERT( xRunTimeWindowTicks[ x ] > ( TickType_t ) 0U );
+                            xRunTimeWindowTicksLeft[ x ] = xRunTimeWindowTicks[ x ];
+                            ulRunTimeWindowStart[ x ] = ulTaskSwitchedInTime;
+                        }
+                    }
+                #endif
+            }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
         traceTASK_SWITCHED_IN();
 
         /* Setting up the timer tick is hardware specific and thus in the
@@ -2280,7 +3711,13 @@ void vTaskEndScheduler( void )
 }
 /*----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
+/* With configUSE_CRITICAL_PROFILER, vTaskSuspendAll() is a macro that passes
+ * the call site. */
+#if ( configUSE_CRITICAL_PROFILER == 1 )
+    void vTaskSuspendAllFromSite( uint32_t ulSite )
+#else
+    void vTaskSuspendAll( void )
+#endif
 {
     /* A critical section is not required as the variable is of type
      * BaseType_t.  Please read Richard Barry's reply in the following link to a
@@ -2298,10 +3735,46 @@ void vTaskSuspendAll( void )
     /* Enforces ordering for ports and optimised compilers that may otherwise place
      * the above increment elsewhere. */
     portMEMORY_BARRIER();
+
+    #if ( configUSE_CRITICAL_PROFILER == 1 )
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+            {
+                vCriticalProfilerSuspend( ulSite );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
 }
 /*----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+    static TickType_t prvGetExpectedIdleTime( void )
+    {
+        TickType_t xReturn;
+
+        /* The idle task is sorted last in the EDF ready list, so any other task
+         * in that list is ready to run. */
+        if( ( pxCurrentTCB != xIdleTaskHandle ) || ( listCURRENT_LIST_LENGTH( &( xReadyTasksListEDF ) ) > ( UBaseType_t ) 1 ) )
+        {
+            xReturn = 0;
+        }
+        else
+        {
+            xReturn = xNextTaskUnblockTime - xTickCount;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     static TickType_t prvGetExpectedIdleTime( void )
     {
@@ -2361,7 +3834,7 @@ void vTaskSuspendAll( void )
         return xReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_EDF_SCHEDULER == 0 ) */
 /*----------------------------------------------------------*/
 
 BaseType_t xTaskResumeAll( void )
@@ -2384,6 +3857,12 @@ BaseType_t xTaskResumeAll( void )
 
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
+            #if ( configUSE_CRITICAL_PROFILER == 1 )
+                {
+                    vCriticalProfilerResume();
+                }
+            #endif
+
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
             {
                 /* Move any readied tasks from the pending list into the
@@ -2398,7 +3877,7 @@ BaseType_t xTaskResumeAll( void )
 
                     /* If the moved task has a priority higher than or equal to
                      * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( taskPOLICY_PREEMPTS_OR_TIES( pxTCB ) )
                     {
                         xYieldPending = pdTRUE;
                     }
@@ -2624,17 +4103,26 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
         vTaskSuspendAll();
         {
             /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
-
-                if( pxTCB != NULL )
+            #if ( configUSE_EDF_SCHEDULER == 1 )
                 {
-                    /* Found the handle. */
-                    break;
+                    ( void ) uxQueue;
+                    pxTCB = prvSearchForNameWithinSingleList( &xReadyTasksListEDF, pcNameToQuery );
+                }
+            #else
+                {
+                    do
+                    {
+                        uxQueue--;
+                        pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                        if( pxTCB != NULL )
+                        {
+                            /* Found the handle. */
+                            break;
+                        }
+                    } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            #endif /* configUSE_EDF_SCHEDULER */
 
             /* Search the delayed lists. */
             if( pxTCB == NULL )
@@ -2690,11 +4178,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
             {
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Ready state. */
-                do
-                {
-                    uxQueue--;
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
-                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        ( void ) uxQueue;
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xReadyTasksListEDF, eReady );
+                    }
+                #else
+                    {
+                        do
+                        {
+                            uxQueue--;
+                            uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                        } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                #endif /* configUSE_EDF_SCHEDULER */
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
@@ -2854,7 +4351,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          * performed if the unblocked task has a priority that is
                          * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPOLICY_PREEMPTS( pxTCB ) )
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -2901,6 +4398,18 @@ BaseType_t xTaskIncrementTick( void )
          * delayed lists if it wraps to 0. */
         xTickCount = xConstTickCount;
 
+        #if ( configRUN_TIME_WINDOWS > 0 )
+            {
+                prvRunTimeWindowsTick();
+            }
+        #endif
+
+        #if ( configUSE_JOB_STATS == 1 )
+            {
+                ulJobStatsTickTime = configJOB_STATS_TIMESTAMP();
+            }
+        #endif
+
         if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
         {
             taskSWITCH_DELAYED_LISTS();
@@ -2910,6 +4419,19 @@ BaseType_t xTaskIncrementTick( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_LOGICAL_EXECUTION_TIME == 1 )
+            {
+                if( ( xConstTickCount == xNextLetInstant ) && ( pxLetTasks != NULL ) )
+                {
+                    prvLetTick( xConstTickCount );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
         /* See if this tick has made a timeout expire.  Tasks are stored in
          * the  queue in the order of their wake time - meaning once one task
          * has been found whose block time has not expired there is no need to
@@ -2963,7 +4485,9 @@ BaseType_t xTaskIncrementTick( void )
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* Only a delay was waited for, which is how the
+                         * next job of a periodic task is released. */
+                        traceTASK_RELEASE( pxTCB );
                     }
 
                     /* Place the unblocked task into the appropriate ready
@@ -2978,41 +4502,26 @@ BaseType_t xTaskIncrementTick( void )
                              * only be performed if the unblocked task has a
                              * priority that is equal to or higher than the
                              * currently executing task. */
-
-                            #if (configUSE_EDF_SCHEDULER == 1)
-                                listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), (pxTCB)->xTaskPeriod + xConstTickCount);
-                               // vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) );
-                                if( pxTCB->xStateListItem.xItemValue < pxCurrentTCB->xStateListItem.xItemValue )
-                                {
-                                    xSwitchRequired = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                           
-                            #else
-                                if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                                {
-                                    xSwitchRequired = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                             #endif /*configUSE_EDF_SCHEDULER*/
+                            if( taskPOLICY_PREEMPTS_OR_TIES_AT_TICK( pxTCB ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                     #endif /* configUSE_PREEMPTION */
                 }
             }
         }
 
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        /* Let the scheduling policy decide if the running task should give
+         * up the processor on this tick - time slicing between tasks of equal
+         * priority, or a change of laxity. */
+        #if ( configUSE_PREEMPTION == 1 )
             {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                if( taskPOLICY_TICK_PREEMPTS() != pdFALSE )
                 {
                     xSwitchRequired = pdTRUE;
                 }
@@ -3021,7 +4530,7 @@ BaseType_t xTaskIncrementTick( void )
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+        #endif /* configUSE_PREEMPTION */
 
         #if ( configUSE_TICK_HOOK == 1 )
             {
@@ -3190,37 +4699,42 @@ void vTaskSwitchContext( void )
     }
     else
     {
+        #if ( ( configUSE_JOB_STATS == 1 ) || ( configUSE_CPU_ACCOUNTING == 1 ) || ( configUSE_CRITICAL_PROFILER == 1 ) )
+            TCB_t * const pxPreviousTCB = pxCurrentTCB;
+        #endif
+
         xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
 
+        /* The time is taken before the switched out hook so that, with
+         * configUSE_CPU_ACCOUNTING, the hook is not charged to the task. */
         #if ( configGENERATE_RUN_TIME_STATS == 1 )
             {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                ulTotalRunTime = prvGetRunTimeCounterValue();
+
+                #if ( configUSE_CPU_ACCOUNTING == 1 )
+                    {
+                        /* Called from an interrupt, the task was charged when
+                         * the interrupt started. */
+                        if( uxActiveISR != taskNO_ISR )
+                        {
+                            ulISRRunTime[ uxActiveISR ] += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                            ulTaskSwitchedInTime = ulTotalRunTime;
+                        }
+                        else
+                        {
+                            prvChargeCurrentTask( ulTotalRunTime );
+                        }
+                    }
                 #else
-                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    {
+                        prvChargeCurrentTask( ulTotalRunTime );
+                    }
                 #endif
-
-                /* Add the amount of time the task has been running to the
-                 * accumulated time so far.  The time the task started running was
-                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-                 * protection here so count values are only valid until the timer
-                 * overflows.  The guard against negative values is to protect
-                 * against suspect run time stat counter implementations - which
-                 * are provided by the application, not the kernel. */
-                if( ulTotalRunTime > ulTaskSwitchedInTime )
-                {
-                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                ulTaskSwitchedInTime = ulTotalRunTime;
             }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
+        traceTASK_SWITCHED_OUT();
+
         /* Check for stack overflow, if configured. */
         taskCHECK_FOR_STACK_OVERFLOW();
 
@@ -3231,15 +4745,73 @@ void vTaskSwitchContext( void )
             }
         #endif
 
+        #if ( configUSE_CPU_ACCOUNTING == 1 )
+            {
+                prvChargeAccounting( &ulSwitchRunTime );
+            }
+        #endif
+
         /* Select a new task to run using either the generic C or port
          * optimised asm code. */
+        taskPOLICY_SELECT_NEXT_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-        #if (configUSE_EDF_SCHEDULER == 1)
-            pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
-        #else
-            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #if ( configUSE_CPU_ACCOUNTING == 1 )
+            {
+                prvChargeAccounting( &ulSchedulerRunTime );
+            }
         #endif
 
+        #if ( configUSE_JOB_STATS == 1 )
+            {
+                if( pxCurrentTCB != pxPreviousTCB )
+                {
+                    /* A task switched out while still in the ready list did
+                     * not block, something more urgent took over. */
+                    if( listIS_CONTAINED_WITHIN( &xReadyTasksListEDF, &( pxPreviousTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        ( pxPreviousTCB->uxPreemptions )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ( pxCurrentTCB->uxContextSwitches )++;
+
+                    if( pxCurrentTCB->ucJobStarted == pdFALSE )
+                    {
+                        pxCurrentTCB->ulJobStartTime = configJOB_STATS_TIMESTAMP();
+                        pxCurrentTCB->ucJobStarted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_JOB_STATS */
+
+        #if ( configUSE_CRITICAL_PROFILER == 1 )
+            {
+                /* A task that yields inside a critical section takes its
+                 * nesting with it, as the port does with the critical nesting
+                 * count, so the task switched in starts from its own. */
+                if( pxCurrentTCB != pxPreviousTCB )
+                {
+                    pxPreviousTCB->uxCriticalDepth = uxCriticalProfilerSwitchOut( &( pxPreviousTCB->ulCriticalSite ) );
+                    vCriticalProfilerSwitchIn( pxCurrentTCB->uxCriticalDepth, pxCurrentTCB->ulCriticalSite );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_CRITICAL_PROFILER */
+
         traceTASK_SWITCHED_IN();
 
         /* After the new task is switched in, update the global errno. */
@@ -3258,6 +4830,21 @@ void vTaskSwitchContext( void )
                 _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
             }
         #endif /* configUSE_NEWLIB_REENTRANT */
+
+        #if ( configUSE_CPU_ACCOUNTING == 1 )
+            {
+                if( pxCurrentTCB != pxPreviousTCB )
+                {
+                    uxContextSwitchCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvChargeAccounting( &ulSwitchRunTime );
+            }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -3277,7 +4864,8 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
      * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
      * Normally, the xItemValue of a TCB's ListItem_t members is:
      *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
+     * Therefore, the event list is sorted in descending priority order.  Under
+     * EDF every task has the same value, see taskEVENT_LIST_ITEM_VALUE().
      *
      * The queue that contains the event list is locked, preventing
      * simultaneous access from interrupts. */
@@ -3396,7 +4984,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPOLICY_PREEMPTS( pxUnblockedTCB ) )
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3454,7 +5042,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPOLICY_PREEMPTS( pxUnblockedTCB ) )
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3652,10 +5240,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
                  * the ready list at the idle priority contains more than one task
                  * then a task other than the idle task is ready to execute. */
                 
-                //Change Idel Task Deadline
+                /* The idle task is always sorted last in the EDF ready list,
+                 * so any other task in that list should run instead. */
                 #if (configUSE_EDF_SCHEDULER == 1)
-                    listSET_LIST_ITEM_VALUE( &( ( xIdleTaskHandle )->xStateListItem ), (xIdleTaskHandle)->xTaskPeriod + xTaskGetTickCount());
-                    //vListInsert( &(xReadyTasksListEDF), &( ( xIdleTaskHandle )->xStateListItem ) );
                     if( listCURRENT_LIST_LENGTH( &( xReadyTasksListEDF ) ) > ( UBaseType_t ) 1 )
                     {
                         taskYIELD();
@@ -3851,12 +5438,16 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 static void prvInitialiseTaskLists( void )
 {
-    UBaseType_t uxPriority;
+    #if ( configUSE_EDF_SCHEDULER == 0 )
+        {
+            UBaseType_t uxPriority;
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
-    {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+            for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+            {
+                vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+            }
+        }
+    #endif
 
     vListInitialise( &xDelayedTaskList1 );
     vListInitialise( &xDelayedTaskList2 );
@@ -3928,11 +5519,20 @@ static void prvCheckTasksWaitingTermination( void )
 
         pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
         pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
         pxTaskStatus->pxStackBase = pxTCB->pxStack;
         pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
-        #if ( configUSE_MUTEXES == 1 )
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            {
+                pxTaskStatus->uxCurrentPriority = tskIDLE_PRIORITY;
+            }
+        #else
+            {
+                pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+            }
+        #endif
+
+        #if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
             {
                 pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
             }
@@ -4136,6 +5736,100 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STACK_WATERMARKS == 1 )
+
+    BaseType_t xTaskStackWatermarkStep( TaskHandle_t xTask,
+                                        UBaseType_t uxMaxWords )
+    {
+        TCB_t * pxTCB;
+        const StackType_t * pxWord;
+        UBaseType_t uxChecked = ( UBaseType_t ) 0U;
+        BaseType_t xPassComplete = pdFALSE;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Only the words that were free at the end of the last pass are
+         * checked, from the far end of the stack.  The task may be running
+         * meanwhile, anything it writes to a word already checked is seen by
+         * the next pass. */
+        while( uxChecked < uxMaxWords )
+        {
+            if( pxTCB->uxStackScanned >= pxTCB->uxStackFree )
+            {
+                /* No deeper use since the last pass. */
+                xPassComplete = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( portSTACK_GROWTH < 0 )
+                {
+                    pxWord = pxTCB->pxStack + pxTCB->uxStackScanned;
+                }
+            #else
+                {
+                    pxWord = pxTCB->pxEndOfStack - pxTCB->uxStackScanned;
+                }
+            #endif
+
+            if( *pxWord != tskSTACK_FILL_WORD )
+            {
+                pxTCB->uxStackFree = pxTCB->uxStackScanned;
+                xPassComplete = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ( pxTCB->uxStackScanned )++;
+            uxChecked++;
+        }
+
+        if( xPassComplete != pdFALSE )
+        {
+            pxTCB->uxStackScanned = ( configSTACK_DEPTH_TYPE ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xPassComplete;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetStackReport( TaskHandle_t xTask,
+                              TaskStackReport_t * pxReport )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxRecommended;
+        const UBaseType_t uxAlignmentWords = ( UBaseType_t ) ( ( portBYTE_ALIGNMENT + sizeof( StackType_t ) - 1U ) / sizeof( StackType_t ) );
+
+        configASSERT( pxReport );
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+        pxReport->uxStackDepth = pxTCB->uxStackDepth;
+        pxReport->uxStackUsed = ( configSTACK_DEPTH_TYPE ) ( pxTCB->uxStackDepth - pxTCB->uxStackFree );
+
+        uxRecommended = ( UBaseType_t ) pxReport->uxStackUsed;
+        uxRecommended += ( ( uxRecommended * ( UBaseType_t ) configSTACK_WATERMARK_MARGIN_PERCENT ) + ( UBaseType_t ) 99U ) / ( UBaseType_t ) 100U;
+        uxRecommended += ( UBaseType_t ) configSTACK_WATERMARK_MARGIN_WORDS;
+
+        /* The top of the stack is aligned down when the task is created, so
+         * words past a multiple of the alignment would be wasted. */
+        uxRecommended = ( ( uxRecommended + uxAlignmentWords - ( UBaseType_t ) 1U ) / uxAlignmentWords ) * uxAlignmentWords;
+
+        pxReport->uxRecommendedDepth = ( configSTACK_DEPTH_TYPE ) uxRecommended;
+    }
+
+#endif /* configUSE_STACK_WATERMARKS */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
@@ -4160,7 +5854,7 @@ static void prvCheckTasksWaitingTermination( void )
                 /* The task can only have been allocated dynamically - free both
                  * the stack and TCB. */
                 vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                taskFREE_TCB( pxTCB );
             }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
             {
@@ -4172,13 +5866,13 @@ static void prvCheckTasksWaitingTermination( void )
                     /* Both the stack and TCB were allocated dynamically, so both
                      * must be freed. */
                     vPortFreeStack( pxTCB->pxStack );
-                    vPortFree( pxTCB );
+                    taskFREE_TCB( pxTCB );
                 }
                 else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
                 {
                     /* Only the stack was statically allocated, so the TCB is the
                      * only memory that must be freed. */
-                    vPortFree( pxTCB );
+                    taskFREE_TCB( pxTCB );
                 }
                 else
                 {
@@ -4260,7 +5954,7 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
     {
@@ -4350,7 +6044,7 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
     {
@@ -4430,7 +6124,7 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
 
     void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                               UBaseType_t uxHighestPriorityWaitingTask )
@@ -4536,6 +6230,55 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+/* Tasks have no priority to inherit under EDF, the holder of a mutex keeps
+ * the deadline of its own job.  Only the count of mutexes held is kept. */
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    {
+        ( void ) pxMutexHolder;
+
+        return pdFALSE;
+    }
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+    {
+        TCB_t * const pxTCB = pxMutexHolder;
+
+        if( pxMutexHolder != NULL )
+        {
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdFALSE;
+    }
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
+    {
+        ( void ) pxMutexHolder;
+        ( void ) uxHighestPriorityWaitingTask;
+    }
+
+#endif /* ( configUSE_MUTEXES == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
     void vTaskEnterCritical( void )
@@ -4867,7 +6610,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
     /* Reset the event list item to its normal value - so it can be used with
      * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), taskEVENT_LIST_ITEM_VALUE( pxCurrentTCB ) );
 
     return uxReturn;
 }
@@ -5147,7 +6890,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPOLICY_PREEMPTS( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5282,7 +7025,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPOLICY_PREEMPTS( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5373,7 +7116,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPOLICY_PREEMPTS( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5498,6 +7241,268 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetRunTimeCounterValue( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        return ulNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvChargeCurrentTask( configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        /* Add the amount of time the task has been running to the
+         * accumulated time so far.  The time the task started running was
+         * stored in ulTaskSwitchedInTime.  The counter is free running, so
+         * the unsigned difference is right across a wrap, as long as no task
+         * runs for a whole counter period without being charged. */
+        pxCurrentTCB->ulRunTimeCounter += ( ulNow - ulTaskSwitchedInTime );
+
+        #if ( configRUN_TIME_WINDOWS > 0 )
+            {
+                prvChargeRunTimeWindows( pxCurrentTCB, ulTaskSwitchedInTime, ulNow );
+            }
+        #endif
+
+        ulTaskSwitchedInTime = ulNow;
+    }
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CPU_ACCOUNTING == 1 )
+
+    static void prvChargeAccounting( configRUN_TIME_COUNTER_TYPE * pulBucket )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow = prvGetRunTimeCounterValue();
+
+        *pulBucket += ( ulNow - ulTaskSwitchedInTime );
+        ulTaskSwitchedInTime = ulNow;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskAccountingISREnter( UBaseType_t uxIsr )
+    {
+        configASSERT( uxIsr < ( UBaseType_t ) configACCOUNTING_ISRS );
+        configASSERT( uxActiveISR == taskNO_ISR );
+
+        /* Before the scheduler starts there is no task to take the time
+         * from, and the time is not counted. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            prvChargeCurrentTask( prvGetRunTimeCounterValue() );
+            uxActiveISR = uxIsr;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskAccountingISRExit( void )
+    {
+        /* The interrupt may have switched tasks, the time from here on goes
+         * to whichever task is now running. */
+        if( uxActiveISR != taskNO_ISR )
+        {
+            prvChargeAccounting( &( ulISRRunTime[ uxActiveISR ] ) );
+            uxActiveISR = taskNO_ISR;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetCpuAccounting( TaskCpuAccounting_t * pxAccounting )
+    {
+        UBaseType_t x;
+
+        configASSERT( pxAccounting );
+
+        taskENTER_CRITICAL();
+        {
+            for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configACCOUNTING_ISRS; x++ )
+            {
+                pxAccounting->ulISRTime[ x ] = ulISRRunTime[ x ];
+            }
+
+            pxAccounting->ulSchedulerTime = ulSchedulerRunTime;
+            pxAccounting->ulSwitchTime = ulSwitchRunTime;
+            pxAccounting->ulTotalTime = prvGetRunTimeCounterValue() - ulSchedulerStartTime;
+            pxAccounting->uxContextSwitches = uxContextSwitchCount;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_CPU_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configRUN_TIME_WINDOWS > 0 )
+
+    static void prvChargeRunTimeWindows( TCB_t * pxTCB,
+                                         configRUN_TIME_COUNTER_TYPE ulSwitchedInTime,
+                                         configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulRan, ulBeforeStart, ulInLastWindow;
+        UBaseType_t x, uxWindowsPassed;
+
+        ulRan = ulNow - ulSwitchedInTime;
+
+        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configRUN_TIME_WINDOWS; x++ )
+        {
+            uxWindowsPassed = uxRunTimeWindow[ x ] - pxTCB->uxRunTimeWindow[ x ];
+
+            if( uxWindowsPassed == ( UBaseType_t ) 0U )
+            {
+                pxTCB->ulWindowRunTime[ x ] += ulRan;
+            }
+            else
+            {
+                /* The part of the run before the current window started.  The
+                 * difference wraps to more than ulRan if the task was switched
+                 * in after the start. */
+                ulBeforeStart = ulRunTimeWindowStart[ x ] - ulSwitchedInTime;
+
+                if( ulBeforeStart > ulRan )
+                {
+                    ulBeforeStart = ( configRUN_TIME_COUNTER_TYPE ) 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Of that, only what fell in the last complete window counts,
+                 * along with what was charged to it before if the task last
+                 * ran in it. */
+                ulInLastWindow = ulBeforeStart;
+
+                if( ulInLastWindow > ulRunTimeWindowLength[ x ] )
+                {
+                    ulInLastWindow = ulRunTimeWindowLength[ x ];
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( uxWindowsPassed == ( UBaseType_t ) 1U )
+                {
+                    ulInLastWindow += pxTCB->ulWindowRunTime[ x ];
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->ulLastWindowRunTime[ x ] = ulInLastWindow;
+                pxTCB->ulWindowRunTime[ x ] = ulRan - ulBeforeStart;
+                pxTCB->uxRunTimeWindow[ x ] = uxRunTimeWindow[ x ];
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunTimeWindowsTick( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow = prvGetRunTimeCounterValue();
+        UBaseType_t x;
+
+        for( x = ( UBaseType_t ) 0U; x < ( UBaseType_t ) configRUN_TIME_WINDOWS; x++ )
+        {
+            xRunTimeWindowTicksLeft[ x ]--;
+
+            if( xRunTimeWindowTicksLeft[ x ] == ( TickType_t ) 0U )
+            {
+                /* Tasks are charged for the window that ended the next time
+                 * they are switched out, or read. */
+                xRunTimeWindowTicksLeft[ x ] = xRunTimeWindowTicks[ x ];
+                ulRunTimeWindowLength[ x ] = ulNow - ulRunTimeWindowStart[ x ];
+                ulRunTimeWindowStart[ x ] = ulNow;
+                uxRunTimeWindow[ x ]++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetRunTimeWindow( TaskHandle_t xTask,
+                                UBaseType_t uxWindow,
+                                TaskRunTimeWindow_t * pxWindow )
+    {
+        TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulRunTime;
+        UBaseType_t uxWindowsPassed;
+
+        configASSERT( uxWindow < ( UBaseType_t ) configRUN_TIME_WINDOWS );
+        configASSERT( pxWindow );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The running task has not been charged since it was switched in,
+             * part of which may fall in the window that just ended. */
+            if( pxTCB == pxCurrentTCB )
+            {
+                prvChargeCurrentTask( prvGetRunTimeCounterValue() );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A task that has not run since the last window ended still holds
+             * its time in that window as the current one. */
+            uxWindowsPassed = uxRunTimeWindow[ uxWindow ] - pxTCB->uxRunTimeWindow[ uxWindow ];
+
+            if( uxWindowsPassed == ( UBaseType_t ) 0U )
+            {
+                ulRunTime = pxTCB->ulLastWindowRunTime[ uxWindow ];
+            }
+            else if( uxWindowsPassed == ( UBaseType_t ) 1U )
+            {
+                ulRunTime = pxTCB->ulWindowRunTime[ uxWindow ];
+            }
+            else
+            {
+                ulRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            }
+
+            pxWindow->ulRunTime = ulRunTime;
+            pxWindow->ulWindowLength = ulRunTimeWindowLength[ uxWindow ];
+            pxWindow->uxWindowNumber = uxRunTimeWindow[ uxWindow ];
+        }
+        taskEXIT_CRITICAL();
+
+        /* The division is left out of the critical section. */
+        if( pxWindow->ulWindowLength > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            pxWindow->usUtilisation = ( uint16_t ) ( ( ( uint64_t ) pxWindow->ulRunTime * tskUTILISATION_SCALE ) / pxWindow->ulWindowLength );
+        }
+        else
+        {
+            pxWindow->usUtilisation = 0U;
+        }
+    }
+
+#endif /* configRUN_TIME_WINDOWS */
+/*-----------------------------------------------------------*/
+
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
@@ -5515,16 +7520,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-    {
-        /* The current task must be in a ready list, so there is no need to
-         * check, and the port reset macro can be called directly. */
-        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    taskPOLICY_DEQUEUE( pxCurrentTCB );
 
     #if ( INCLUDE_vTaskSuspend == 1 )
         {
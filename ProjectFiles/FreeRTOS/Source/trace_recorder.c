@@ -0,0 +1,204 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+#define recorderINDEX_MASK    ( ( UBaseType_t ) configTRACE_RECORDER_BUFFER_LENGTH - ( UBaseType_t ) 1U )
+
+PRIVILEGED_DATA static TraceEvent_t xEvents[ configTRACE_RECORDER_BUFFER_LENGTH ];
+
+/* Number of events recorded since the last start.  Only the latest
+ * configTRACE_RECORDER_BUFFER_LENGTH of them are still in xEvents. */
+PRIVILEGED_DATA static volatile UBaseType_t uxEventsRecorded = ( UBaseType_t ) 0U;
+
+/* Events still to record before stopping, 0 until a trigger mode recording
+ * sees its deadline miss. */
+PRIVILEGED_DATA static volatile UBaseType_t uxEventsToStop = ( UBaseType_t ) 0U;
+
+PRIVILEGED_DATA static volatile TraceMode_t eTraceMode = eTraceSnapshot;
+PRIVILEGED_DATA static volatile BaseType_t xStopped = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+void vTraceStart( TraceMode_t eMode )
+{
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = configTRACE_RECORDER_MASK_INTERRUPTS();
+    {
+        uxEventsRecorded = ( UBaseType_t ) 0U;
+        uxEventsToStop = ( UBaseType_t ) 0U;
+        eTraceMode = eMode;
+        xStopped = pdFALSE;
+    }
+    configTRACE_RECORDER_UNMASK_INTERRUPTS( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceStop( void )
+{
+    xStopped = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTraceIsStopped( void )
+{
+    return xStopped;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTraceGetEventCount( void )
+{
+    UBaseType_t uxCount = ( UBaseType_t ) 0U;
+
+    if( xStopped != pdFALSE )
+    {
+        uxCount = uxEventsRecorded;
+
+        if( uxCount > ( UBaseType_t ) configTRACE_RECORDER_BUFFER_LENGTH )
+        {
+            uxCount = ( UBaseType_t ) configTRACE_RECORDER_BUFFER_LENGTH;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTraceGetEvents( TraceEvent_t * pxBuffer,
+                              UBaseType_t uxFirst,
+                              UBaseType_t uxMaxEvents )
+{
+    UBaseType_t uxCount = uxTraceGetEventCount();
+    UBaseType_t uxOldest, uxCopied;
+
+    configASSERT( pxBuffer );
+
+    /* The oldest event held is the one after the newest, once the buffer has
+     * wrapped. */
+    uxOldest = uxEventsRecorded - uxCount;
+
+    for( uxCopied = ( UBaseType_t ) 0U; ( uxCopied < uxMaxEvents ) && ( ( uxFirst + uxCopied ) < uxCount ); uxCopied++ )
+    {
+        pxBuffer[ uxCopied ] = xEvents[ ( uxOldest + uxFirst + uxCopied ) & recorderINDEX_MASK ];
+    }
+
+    return uxCopied;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecord( uint8_t ucEvent,
+                   UBaseType_t uxTask,
+                   uint32_t ulParam )
+{
+    TraceEvent_t * pxEvent;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = configTRACE_RECORDER_MASK_INTERRUPTS();
+    {
+        if( xStopped == pdFALSE )
+        {
+            pxEvent = &( xEvents[ uxEventsRecorded & recorderINDEX_MASK ] );
+            pxEvent->ulTimestamp = ( uint32_t ) configTRACE_RECORDER_TIMESTAMP();
+            pxEvent->ucEvent = ucEvent;
+            pxEvent->ucTask = ( uint8_t ) uxTask;
+            pxEvent->usParam = ( uint16_t ) ulParam;
+            uxEventsRecorded++;
+
+            if( uxEventsToStop != ( UBaseType_t ) 0U )
+            {
+                uxEventsToStop--;
+
+                if( uxEventsToStop == ( UBaseType_t ) 0U )
+                {
+                    xStopped = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( ucEvent == recorderEVENT_DEADLINE_MISS ) && ( eTraceMode == eTraceTriggerOnMiss ) )
+            {
+                /* The miss itself is already recorded. */
+                uxEventsToStop = ( UBaseType_t ) configTRACE_RECORDER_POST_TRIGGER;
+
+                if( uxEventsToStop == ( UBaseType_t ) 0U )
+                {
+                    xStopped = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    configTRACE_RECORDER_UNMASK_INTERRUPTS( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordCurrent( uint8_t ucEvent,
+                          uint32_t ulParam )
+{
+    /* The task number is 0 before the scheduler has a task to run. */
+    vTraceRecord( ucEvent, uxTaskGetTaskNumber( xTaskGetCurrentTaskHandle() ), ulParam );
+}
+
+#endif /* configUSE_TRACE_RECORDER */
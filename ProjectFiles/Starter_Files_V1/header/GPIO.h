@@ -50,13 +50,30 @@ typedef enum
 
 }pinState_t;
 
+/* Set and clear registers of a pin's port and the pin's bit, so the pin is written with a single store */
+typedef struct
+{
+	volatile uint32_t *pulSet;
+	volatile uint32_t *pulClear;
+	uint32_t ulMask;
+
+}gpioProbe_t;
+
+extern gpioProbe_t GPIO_taskProbes[];		/* Indexed by task tag, idle first */
+extern gpioProbe_t GPIO_tickProbe;
+
+#define GPIO_PROBE_HIGH(pxProbe)		(*((pxProbe)->pulSet) = (pxProbe)->ulMask)
+#define GPIO_PROBE_LOW(pxProbe)			(*((pxProbe)->pulClear) = (pxProbe)->ulMask)
+#define GPIO_TASK_PROBE(taskTag)		(&GPIO_taskProbes[(uint32_t)(taskTag)])
+
 
 /************ Function declaration section ***********/
 
 extern void GPIO_init(void);
 extern pinState_t GPIO_read(portX_t PortName, pinX_t pinNum);
 extern void GPIO_write(portX_t PortName, pinX_t PinNum, pinState_t pinState);
-pinX_t TagToPinMap (uint8_t taskTag);
+extern void GPIO_writeMasked(portX_t portName, uint32_t ulMask, uint32_t ulValue);
+extern void GPIO_probeInit(gpioProbe_t *pxProbe, portX_t portName, pinX_t pinNum);
 
 
 
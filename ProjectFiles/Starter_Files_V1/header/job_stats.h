@@ -0,0 +1,64 @@
+#ifndef JOB_STATS_H_
+#define JOB_STATS_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "telemetry.h"
+
+/* Byte received on UART1 that starts a dump of the job statistics of every task in the task table */
+#define JOB_STATS_COMMAND				((signed char)'j')
+
+#if (configJOB_STATS_BUCKETS > 32)
+	#error TLM_JOB_BUCKET has 5 bits for the bucket
+#endif
+
+/* Counters sent in TLM_JOB_COUNTER records */
+typedef enum
+{
+	JOB_STATS_JOBS,
+	JOB_STATS_CONTEXT_SWITCHES,
+	JOB_STATS_PREEMPTIONS,
+	JOB_STATS_DEADLINE_MISSES,
+	JOB_STATS_COUNTER_COUNT
+
+}jobStatsCounter_t;
+
+/* TLM_JOB_COUNTER value: jobStatsCounter_t in the low 2 bits, the count above */
+#define JOB_STATS_COUNTER_VALUE(counter, count)				((uint32_t)(counter) | ((uint32_t)(count) << 2))
+
+/* TLM_JOB_BUCKET value: eJobHistogram in the low 2 bits, the bucket in the next 5, the count above */
+#define JOB_STATS_BUCKET_VALUE(histogram, bucket, count)	((uint32_t)(histogram) | ((uint32_t)(bucket) << 2) | ((uint32_t)(count) << 7))
+
+/* Where the CPU time went, sent in TLM_CPU_BUCKET records */
+typedef enum
+{
+	CPU_BUCKET_TASK,				/* The task of the TLM_JOB_TASK record before it */
+	CPU_BUCKET_IDLE,
+	CPU_BUCKET_SCHEDULER,
+	CPU_BUCKET_SWITCH,
+	CPU_BUCKET_SWITCHES,			/* Number of context switches, not a time */
+	CPU_BUCKET_TOTAL,				/* Time since the scheduler started */
+	CPU_BUCKET_ISR,					/* The ISR numbered in FreeRTOSConfig.h, one record each */
+	CPU_BUCKET_COUNT
+
+}cpuBucket_t;
+
+/* TLM_CPU_BUCKET value: cpuBucket_t in the low 3 bits, the ISR number above */
+#define JOB_STATS_CPU_BUCKET_VALUE(bucket, isr)			((uint32_t)(bucket) | ((uint32_t)(isr) << 3))
+
+#if (configUSE_CRITICAL_PROFILER == 1) && (configCRITICAL_PROFILER_BUCKETS > 32)
+	#error TLM_SITE_BUCKET has 5 bits for the bucket
+#endif
+
+/* TLM_SITE_BUCKET value: the bucket in the low 5 bits, the count above */
+#define JOB_STATS_SITE_BUCKET_VALUE(bucket, count)			((uint32_t)(bucket) | ((uint32_t)(count) << 5))
+
+
+/************ Function declaration section ***********/
+
+extern void JobStats_poll(const PeriodicTaskParameters_t * pxTaskTable, UBaseType_t uxTaskCount);
+
+
+#endif /* JOB_STATS_H_ */
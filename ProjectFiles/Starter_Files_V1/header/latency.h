@@ -0,0 +1,64 @@
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+
+/* Timestamps are counts of timer 1, which runs at PCLK / (T1PR + 1) */
+#define LATENCY_TIMER_PRESCALE			((uint32_t)1001)
+#define LATENCY_COUNTS_TO_US(counts)	((uint32_t)(((uint64_t)(counts) * LATENCY_TIMER_PRESCALE) / (configCPU_CLOCK_HZ / 1000000UL)))
+
+/* Histogram of the end-to-end latency: bins of 2^LATENCY_BIN_SHIFT counts (~1ms), the last bin holds everything above */
+#define LATENCY_BIN_SHIFT				((uint8_t)6)
+#define LATENCY_BIN_COUNT				((uint8_t)32)
+
+/* Points a message passes on its way from a producer to the UART */
+typedef enum
+{
+	HOP_PRODUCED,		/* Event seen by the producer task */
+	HOP_QUEUED,			/* Reference posted to the consumer queue */
+	HOP_DEQUEUED,		/* Taken from the queue by the consumer */
+	HOP_SENT,			/* Batch queued for transmission by the UART */
+	HOP_COUNT
+
+}latencyHop_t;
+
+/* Producer to UART chains that are measured separately */
+typedef enum
+{
+	CHAIN_BUTTON_1,
+	CHAIN_BUTTON_2,
+	CHAIN_PERIODIC,
+	CHAIN_COUNT
+
+}latencyChain_t;
+
+/* Carried inside every message */
+typedef struct
+{
+	uint32_t ulStamp[HOP_COUNT];
+
+}latencyStamps_t;
+
+typedef struct
+{
+	uint32_t ulCount;
+	uint32_t ulMin;								/* End-to-end latency, in timer 1 counts */
+	uint32_t ulAvg;
+	uint32_t ulMax;
+	uint32_t ulHopAvg[HOP_COUNT - 1];			/* Time spent between each hop and the next */
+	uint32_t ulHopMax[HOP_COUNT - 1];
+	uint32_t ulHistogram[LATENCY_BIN_COUNT];
+
+}latencyStats_t;
+
+
+/************ Function declaration section ***********/
+
+extern void Latency_stamp(latencyStamps_t * pxStamps, latencyHop_t eHop);
+extern void Latency_record(latencyChain_t eChain, const latencyStamps_t * pxStamps);
+extern void Latency_getStats(latencyChain_t eChain, latencyStats_t * pxStats);
+extern void Latency_reset(latencyChain_t eChain);
+
+
+#endif /* LATENCY_H_ */
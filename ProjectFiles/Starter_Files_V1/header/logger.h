@@ -0,0 +1,63 @@
+#ifndef LOGGER_H_
+#define LOGGER_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+#include "telemetry.h"
+
+/* Format strings, only the host decoder reads them, the target just logs the index. Arguments are 32 bit words, formatted with %u, %d or %x */
+#define LOG_FORMATS(ENTRY)																												\
+					ENTRY(LOG_RECORDS_LOST,			"Log source %u lost %u records")						\
+					ENTRY(LOG_MESSAGE_DROPPED,		"Chain %u message dropped, consumer queue full")		\
+					ENTRY(LOG_MESSAGE_EVICTED,		"Chain %u message evicted by a more urgent one")		\
+					ENTRY(LOG_CONSUMER_BACKLOG,		"Consumer batch full, %u messages still queued")		\
+					ENTRY(LOG_UART_FRAME_DROPPED,	"UART frame of %u bytes with %u messages dropped")		\
+					ENTRY(LOG_STACK_REPORT,			"Task %u used %u stack words, recommended depth %u")
+
+#define LOG_FORMAT_ID(id, format)		id,
+
+typedef enum
+{
+	LOG_FORMATS(LOG_FORMAT_ID)
+	LOG_FORMAT_COUNT
+
+}logFormat_t;
+
+/* Every source has its own ring, so each ring has a single writer and needs no locking */
+typedef enum
+{
+	LOG_SOURCE_BUTTON_1,
+	LOG_SOURCE_BUTTON_2,
+	LOG_SOURCE_PERIODIC,
+	LOG_SOURCE_CONSUMER,
+	LOG_SOURCE_ISR,						/* Interrupts do not nest on this port, so they can share one */
+	LOG_SOURCE_IDLE,					/* Idle hook */
+	LOG_SOURCE_COUNT
+
+}logSource_t;
+
+#define LOG_RING_LENGTH					((uint32_t)8)		/* Records per source, must be a power of two */
+#define LOG_ARGS_MAX					TELEMETRY_LOG_ARGS_MAX
+
+typedef struct
+{
+	uint32_t ulStamp;
+	uint16_t usFormat;
+	uint8_t ucArgCount;
+	uint32_t ulArgs[LOG_ARGS_MAX];
+
+}logRecord_t;
+
+
+/************ Function declaration section ***********/
+
+extern void Log_write(logSource_t eSource, logFormat_t eFormat, uint8_t ucArgCount, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2);
+extern void Log_drain(void);
+
+#define LOG0(source, format)					Log_write((source), (format), 0, 0, 0, 0)
+#define LOG1(source, format, a)					Log_write((source), (format), 1, (uint32_t)(a), 0, 0)
+#define LOG2(source, format, a, b)				Log_write((source), (format), 2, (uint32_t)(a), (uint32_t)(b), 0)
+#define LOG3(source, format, a, b, c)			Log_write((source), (format), 3, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+
+
+#endif /* LOGGER_H_ */
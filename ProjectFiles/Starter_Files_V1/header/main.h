@@ -2,6 +2,9 @@
 #define _MAIN_H_
 
 #include <stdint.h>
+#include "latency.h"
+#include "telemetry.h"
+#include "logger.h"
 
 #define NUMBER_OF_TASKS				((uint8_t)6)	
 						
@@ -21,9 +24,22 @@
 #define PERIODICITY_TASK_5		((uint8_t)10)
 #define PERIODICITY_TASK_6		((uint8_t)100)
 														
+#define ET_TASK_1							((uint8_t)1)
+#define ET_TASK_2							((uint8_t)1)
+#define ET_TASK_3							((uint8_t)1)
+#define ET_TASK_4							((uint8_t)1)
 #define ET_TASK_5						  ((uint8_t)5)
 #define ET_TASK_6							((uint8_t)12)														
 														
+/* Task table: function, name, period, relative deadline, execution budget, stack depth */
+#define TASK_TABLE(ENTRY)																																																	\
+					ENTRY(Task_1, "Button_1_Monitor",			PERIODICITY_TASK_1, PERIODICITY_TASK_1, ET_TASK_1, configMINIMAL_STACK_SIZE)	\
+					ENTRY(Task_2, "Button_2_Monitor",			PERIODICITY_TASK_2, PERIODICITY_TASK_2, ET_TASK_2, configMINIMAL_STACK_SIZE)	\
+					ENTRY(Task_3, "Periodic_Transmitter",	PERIODICITY_TASK_3, PERIODICITY_TASK_3, ET_TASK_3, configMINIMAL_STACK_SIZE)	\
+					ENTRY(Task_4, "Uart_Receiver",				PERIODICITY_TASK_4, PERIODICITY_TASK_4, ET_TASK_4, configMINIMAL_STACK_SIZE)	\
+					ENTRY(Task_5, "Load_1_Simulation",		PERIODICITY_TASK_5, PERIODICITY_TASK_5, ET_TASK_5, configMINIMAL_STACK_SIZE)	\
+					ENTRY(Task_6, "Load_2_Simulation",		PERIODICITY_TASK_6, PERIODICITY_TASK_6, ET_TASK_6, configMINIMAL_STACK_SIZE)
+
 #define ET_2_COUNT_MAP				((uint16_t)6666)
 #define DUMMY_ET(ET)																									\
 					do{																													\
@@ -36,15 +52,18 @@
 					
 #define MAX_QUEUE_WAIT_TIME 		((uint8_t)5)
 #define QUEUE_LENGTH						((uint8_t)10)	
-#define MESSAGE_BUFFER_SIZE			((uint8_t)25)
+#define CONSUMER_BATCH_SIZE			((uint8_t)4)			/* Messages the consumer drains per period, one telemetry frame */
+#define MESSAGE_PRODUCERS				((uint8_t)3)			/* Task_1 to Task_3 */
+#define MESSAGE_POOL_SIZE				(QUEUE_LENGTH + CONSUMER_BATCH_SIZE + MESSAGE_PRODUCERS)	/* A full queue, a batch held by the consumer and one being filled by each producer */
+#define MESSAGE_DEADLINE_BUTTON		((uint8_t)PERIODICITY_TASK_4)		/* Button edges should go out on the consumer's next run */
+#define MESSAGE_DEADLINE_PERIODIC	((uint8_t)PERIODICITY_TASK_3)		/* Periodic data only has to go out before the next sample */
 
 #define PULSE_TICK() 																										\
 					do{																														\
-						GPIO_write(PROBE_PORT, PROBE_TICK, PIN_IS_HIGH);						\
-						GPIO_write(PROBE_PORT, PROBE_TICK, PIN_IS_LOW);							\
+						GPIO_PROBE_HIGH(&GPIO_tickProbe);														\
+						GPIO_PROBE_LOW(&GPIO_tickProbe);														\
 					}while(0)
 					
-#define TO_ASCII(num)						(num + (uint8_t)48)
 
 /* Constants to setup I/O and processor. */
 #define mainBUS_CLK_FULL	( ( unsigned char ) 0x01 )
@@ -60,20 +79,24 @@ typedef enum{
 }buttonEdge_t;
 
 typedef struct{
-		uint8_t ucMessageID;
-		char ucData[MESSAGE_BUFFER_SIZE];
+		telemetryType_t eType;					/* Telemetry record the message becomes */
+		uint32_t ulValue;
+		latencyChain_t eChain;					/* Chain the message is measured on */
+		latencyStamps_t xStamps;				/* Time it reached each hop on its way to the UART */
 }message_t;
 
+/* One period of Task_4 output, committed to the UART at its deadline */
 typedef struct{
-	uint32_t inTime;
-	//uint32_t outTime;
-	uint32_t totalTime;
-}TaskTime_t;
+		uint8_t ucCount;													/* Messages in the frame */
+		uint16_t usLength;													/* Encoded bytes, delimiter included */
+		latencyChain_t eChains[CONSUMER_BATCH_SIZE];
+		latencyStamps_t xStamps[CONSUMER_BATCH_SIZE];
+		uint8_t ucData[TELEMETRY_FRAME_SIZE(CONSUMER_BATCH_SIZE)];
+}uartFrame_t;
 
 typedef struct{
-	TaskTime_t taskTime[NUMBER_OF_TASKS + 1];
-	uint32_t temp;
-	uint32_t cpu_Load;
+	uint32_t ulWindow;									/* Run time window the load was last worked out for */
+	uint32_t cpu_Load;									/* Time not spent idle in that window, in tskUTILISATION_SCALE parts */
 }performanceEvaluation_t;
 
 
@@ -92,18 +115,7 @@ void vApplicationIdleHook(void);
 
 static void prvSetupHardware( void );
 
-void vInt2String (uint32_t inInteger, char * outString);
-void vStringClear(char * inOutString);
-
-#if ( configUSE_EDF_SCHEDULER == 1 )
-	BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
-													const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-													const configSTACK_DEPTH_TYPE usStackDepth,
-													void * const pvParameters,
-													UBaseType_t uxPriority,
-													TaskHandle_t * const pxCreatedTask ,
-													TickType_t period);
-#endif
-
+void vSendMessage(const message_t * pxMessage, uint32_t ulRelativeDeadline, logSource_t eSource);
+void vUartFrameCommit(void * pvFrame);
 
 #endif /*_MAIN_H_*/
\ No newline at end of file
@@ -86,10 +86,42 @@ typedef enum
 	ser115200
 } eBaud;
 
+/* Transmit path counters, see vSerialGetTxStats(). */
+typedef struct
+{
+	unsigned long ulBytesQueued;		/* Bytes accepted into the transmit buffer. */
+	unsigned long ulBytesDropped;		/* Bytes of strings refused as they did not fit. */
+	unsigned long ulStringsDropped;
+	unsigned long ulHighWaterMark;		/* Most bytes ever waiting to be transmitted. */
+} xSerialTxStats;
+
+/* Receive path counters, see vSerialGetRxStats(). */
+typedef struct
+{
+	unsigned long ulBytesReceived;		/* Bytes stored in the receive ring. */
+	unsigned long ulOverruns;			/* Bytes dropped as the ring was full. */
+	unsigned long ulHardwareOverruns;	/* Times the UART FIFO itself overflowed. */
+	unsigned long ulHighWaterMark;		/* Most bytes ever waiting to be read. */
+} xSerialRxStats;
+
 void xSerialPortInitMinimal( unsigned long ulWantedBaud);
+
+/* Queue a whole string for transmission, or drop it if the transmit buffer
+does not have room.  Never blocks.  The FromISR version is for the tick hook
+and other interrupts, the Wait version blocks the calling task for up to
+xTicksToWait for room and uses its direct to task notification to do so. */
 signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength);
+signed portBASE_TYPE xSerialPutStringFromISR(const signed char * const pcString, unsigned short usStringLength);
+signed portBASE_TYPE xSerialPutStringWait(const signed char * const pcString, unsigned short usStringLength, TickType_t xTicksToWait);
+
+/* Read the next received byte.  Only one task may read.  xSerialGetChar()
+returns pdFALSE straight away when nothing is waiting, xSerialGetCharWait()
+blocks for up to xTicksToWait on the calling task's notification. */
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar);
+signed portBASE_TYPE xSerialGetCharWait(signed char *pcRxedChar, TickType_t xTicksToWait);
 void xSerialPutChar(signed char cOutChar);
+void vSerialGetTxStats( xSerialTxStats *pxStats );
+void vSerialGetRxStats( xSerialRxStats *pxStats );
 
 #endif
 
@@ -0,0 +1,21 @@
+#ifndef STACK_REPORT_H_
+#define STACK_REPORT_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Stack words checked per idle hook call, keeps the idle hook short whatever the stack sizes */
+#define STACK_REPORT_WORDS_PER_POLL		((UBaseType_t)16)
+
+/* Task table entries plus the idle task */
+#define STACK_REPORT_TASKS_MAX			((UBaseType_t)8)
+
+
+/************ Function declaration section ***********/
+
+extern void StackReport_poll(const PeriodicTaskParameters_t * pxTaskTable, UBaseType_t uxTaskCount);
+
+
+#endif /* STACK_REPORT_H_ */
@@ -0,0 +1,81 @@
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+
+/*
+ * Frame on the wire, COBS encoded and terminated by TELEMETRY_DELIMITER:
+ *		header			1 byte, stream in the top 2 bits, then a sequence that increments per frame of that stream
+ *						so the host can count lost frames
+ *		record			repeated until the end of the frame
+ *			type		1 byte, telemetryType_t
+ *			delta		zigzag varint, timer 1 counts since the previous record, the first record of a frame counts from 0
+ *			value		varint
+ *			args		TLM_LOG records only, as many varints as the low 2 bits of the value
+ */
+#define TELEMETRY_DELIMITER				((uint8_t)0x00)
+#define TELEMETRY_RECORD_MAX			((uint16_t)11)		/* Type, then two varints of at most 5 bytes */
+#define TELEMETRY_LOG_ARGS_MAX			((uint8_t)3)
+#define TELEMETRY_LOG_RECORD_MAX		((uint16_t)(TELEMETRY_RECORD_MAX + (TELEMETRY_LOG_ARGS_MAX * 5)))
+#define TELEMETRY_SEQUENCE_MASK			((uint8_t)0x3F)
+
+/* Buffer needed for a frame of n records: the raw bytes, one COBS code byte per 254 of them plus the first, and the delimiter */
+#define TELEMETRY_FRAME_SIZE(n)			((uint16_t)(1 + ((n) * TELEMETRY_RECORD_MAX) + (((1 + ((n) * TELEMETRY_RECORD_MAX)) / 254) + 1) + 1))
+
+/* Record types, the host decoder keeps the same list */
+typedef enum
+{
+	TLM_BUTTON_1_EDGE,			/* Value 1 for rising, 0 for falling */
+	TLM_BUTTON_2_EDGE,
+	TLM_PERIODIC_VALUE,			/* Value of the periodic sample */
+	TLM_LOG,					/* Value is the log format ID shifted left by 2, ored with the argument count */
+	TLM_TRACE_DUMP,				/* Start of a kernel trace dump, value is the number of TLM_TRACE records that follow */
+	TLM_TRACE,					/* One kernel trace event, value packed by TRACE_DUMP_VALUE() */
+	TLM_JOB_TASK,				/* Start of the job statistics of one task, value is its task number */
+	TLM_JOB_COUNTER,			/* One job statistics counter, value packed by JOB_STATS_COUNTER_VALUE() */
+	TLM_JOB_BUCKET,				/* One used histogram bucket, value packed by JOB_STATS_BUCKET_VALUE() */
+	TLM_CPU_BUCKET,				/* Start of a CPU time record, value is a cpuBucket_t then the ISR number for CPU_BUCKET_ISR */
+	TLM_CPU_TIME,				/* Timer 1 counts charged to the bucket before it, a count for CPU_BUCKET_SWITCHES */
+	TLM_SITE_DROPPED,			/* Critical section durations whose call site did not fit in the profiler */
+	TLM_SITE,					/* Start of a critical section call site, value is CriticalSite_t ulSite */
+	TLM_SITE_COUNT,				/* Durations seen at the call site */
+	TLM_SITE_MAX,				/* Longest of them, in configCRITICAL_PROFILER_TIMESTAMP() counts */
+	TLM_SITE_BUCKET,			/* One used histogram bucket, value packed by JOB_STATS_SITE_BUCKET_VALUE() */
+	TLM_TYPE_COUNT
+
+}telemetryType_t;
+
+/* Independent frame streams, each with its own sequence */
+typedef enum
+{
+	TLM_STREAM_EVENTS,			/* Consumer output, built by Task_4 */
+	TLM_STREAM_LOG,				/* Log records, built in the background */
+	TLM_STREAM_TRACE,			/* Kernel trace dumps, built in the background */
+	TLM_STREAM_STATS,			/* Kernel statistics, sent on request */
+	TLM_STREAM_COUNT
+
+}telemetryStream_t;
+
+/* Builds one frame straight into the caller's buffer, encoding as it goes */
+typedef struct
+{
+	uint8_t * pucBuffer;
+	uint16_t usCapacity;
+	uint16_t usLength;
+	uint16_t usCodeIndex;				/* Where the code byte of the current COBS block goes */
+	uint8_t ucCode;
+	uint32_t ulLastStamp;
+
+}telemetryWriter_t;
+
+
+/************ Function declaration section ***********/
+
+extern void Telemetry_begin(telemetryWriter_t * pxWriter, telemetryStream_t eStream, uint8_t * pucBuffer, uint16_t usCapacity);
+extern uint8_t Telemetry_add(telemetryWriter_t * pxWriter, telemetryType_t eType, uint32_t ulStamp, uint32_t ulValue);
+extern uint8_t Telemetry_addLog(telemetryWriter_t * pxWriter, uint32_t ulStamp, uint16_t usFormat, uint8_t ucArgCount, const uint32_t * pulArgs);
+extern uint16_t Telemetry_end(telemetryWriter_t * pxWriter);
+
+
+#endif /* TELEMETRY_H_ */
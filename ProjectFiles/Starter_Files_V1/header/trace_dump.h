@@ -0,0 +1,22 @@
+#ifndef TRACE_DUMP_H_
+#define TRACE_DUMP_H_
+
+/************* Type def section ************/
+#include <stdint.h>
+#include "telemetry.h"
+
+/* Recording restarted after every dump, eTraceSnapshot only stops when vTraceStop() is called */
+#define TRACE_DUMP_MODE					eTraceTriggerOnMiss
+#define TRACE_DUMP_FRAME_EVENTS			((uint16_t)16)
+
+/* TLM_TRACE value: kernel event in the low 4 bits, task number in the next 8, event parameter above */
+#define TRACE_DUMP_VALUE(event, task, param)	((uint32_t)(event) | ((uint32_t)(task) << 4) | ((uint32_t)(param) << 12))
+
+
+/************ Function declaration section ***********/
+
+extern void TraceDump_start(void);
+extern void TraceDump_poll(void);
+
+
+#endif /* TRACE_DUMP_H_ */
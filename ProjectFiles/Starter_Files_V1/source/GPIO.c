@@ -2,12 +2,16 @@
 
 #include <stdint.h>
 #include "bit_math.h"
+#include "FreeRTOS.h"
 #include "main.h"
 #include "GPIO.h"
 #include "GPIO_cfg.h"
 #include "lpc21xx.h"
 
 
+gpioProbe_t GPIO_taskProbes[NUMBER_OF_TASKS + 1];
+gpioProbe_t GPIO_tickProbe;
+
 static const pinX_t tagToPinMap[NUMBER_OF_TASKS + 1] = {
 		PROBE_IDLE,							//idleTask
 		PROBE_TASK_1,						//Task1
@@ -59,6 +63,13 @@ void GPIO_init(void)
 			default:
 		}
 	}
+	
+	/* Work out the probe registers and masks once, context switches then only store them */
+	for(i = 0; i < (NUMBER_OF_TASKS + 1); i++)
+	{
+		GPIO_probeInit(&GPIO_taskProbes[i], PROBE_PORT, tagToPinMap[i]);
+	}
+	GPIO_probeInit(&GPIO_tickProbe, PROBE_PORT, PROBE_TICK);
 }
 
 
@@ -120,6 +131,43 @@ void GPIO_write(portX_t portName, pinX_t pinNum, pinState_t pinState)
 	}
 }
 
-pinX_t TagToPinMap (uint8_t taskTag){
-	return tagToPinMap[taskTag];
+/* Pins set in ulMask take their state from ulValue, all with one store to IOPIN so they change together.
+   IRQs are masked around the read-modify-write so an interrupt writing the same port is not undone, and only
+   unmasked again if they were unmasked on entry, so it can be called from an ISR or a critical section. */
+void GPIO_writeMasked(portX_t portName, uint32_t ulMask, uint32_t ulValue)
+{
+	int iWasMasked = __disable_irq();
+
+	switch(portName)
+	{
+		case PORT_0:
+			IOPIN0 = (IOPIN0 & ~ulMask) | (ulValue & ulMask);
+			break;
+
+		case PORT_1:
+			IOPIN1 = (IOPIN1 & ~ulMask) | (ulValue & ulMask);
+			break;
+	}
+
+	if(iWasMasked == 0)
+	{
+		__enable_irq();
+	}
+}
+
+void GPIO_probeInit(gpioProbe_t *pxProbe, portX_t portName, pinX_t pinNum)
+{
+	switch(portName)
+	{
+		case PORT_0:
+			pxProbe->pulSet = (volatile uint32_t *)&IOSET0;
+			pxProbe->pulClear = (volatile uint32_t *)&IOCLR0;
+			break;
+
+		case PORT_1:
+			pxProbe->pulSet = (volatile uint32_t *)&IOSET1;
+			pxProbe->pulClear = (volatile uint32_t *)&IOCLR1;
+			break;
+	}
+	pxProbe->ulMask = (1UL << pinNum);
 }
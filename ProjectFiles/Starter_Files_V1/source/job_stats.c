@@ -0,0 +1,224 @@
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "serial.h"
+#include "job_stats.h"
+#include "lpc21xx.h"
+
+
+#define JOB_STATS_MAX(a, b)					(((a) > (b)) ? (a) : (b))
+
+/* Records in a frame of a task: the task number, then one per used bucket of a histogram */
+#define JOB_STATS_TASK_RECORDS				(configJOB_STATS_BUCKETS + 1)
+
+#if (configUSE_CPU_ACCOUNTING == 1)
+	/* Time not charged to a task, a pair of records per bucket in one frame after the task table */
+	#define JOB_STATS_CPU_RECORDS			(2 * (CPU_BUCKET_ISR - CPU_BUCKET_IDLE + configACCOUNTING_ISRS))
+#else
+	#define JOB_STATS_CPU_RECORDS			0
+#endif
+
+#if (configUSE_CRITICAL_PROFILER == 1)
+	/* A frame per call site after that: the dropped count, the site, its count and maximum, then the used buckets */
+	#define JOB_STATS_SITE_RECORDS			(4 + configCRITICAL_PROFILER_BUCKETS)
+#else
+	#define JOB_STATS_SITE_RECORDS			0
+#endif
+
+#define JOB_STATS_FRAME_RECORDS				JOB_STATS_MAX(JOB_STATS_TASK_RECORDS, JOB_STATS_MAX(JOB_STATS_CPU_RECORDS, JOB_STATS_SITE_RECORDS))
+
+/* Frame being sent, kept until the UART takes it: the task number, then its counters or the used buckets of one histogram */
+static uint8_t ucStatsFrame[TELEMETRY_FRAME_SIZE(JOB_STATS_FRAME_RECORDS)];
+static uint16_t usStatsFrameLength = 0;
+
+/* Statistics of the task being dumped, read once so all its frames agree */
+static TaskJobStats_t xStats;
+static UBaseType_t uxMisses;
+#if (configUSE_CPU_ACCOUNTING == 1)
+	static TaskStatus_t xStatus;
+	static TaskCpuAccounting_t xAccounting;
+#endif
+#if (configUSE_CRITICAL_PROFILER == 1)
+	static CriticalSite_t xSite;
+#endif
+
+/* Task table entry being dumped, and the frame of it: the counters, then one per histogram.
+ * Past the task table, the frame counts the frames sent after it. */
+static UBaseType_t uxDumpTask = 0;
+static UBaseType_t uxDumpPart = 0;
+static uint8_t ucDumping = 0;
+
+static void JobStats_frame(void)
+{
+	telemetryWriter_t xWriter;
+	uint32_t ulStamp = T1TC;
+	UBaseType_t uxBucket;
+
+	Telemetry_begin(&xWriter, TLM_STREAM_STATS, ucStatsFrame, sizeof(ucStatsFrame));
+	/* Tasks are numbered from 1 in task table order, as in the kernel trace */
+	Telemetry_add(&xWriter, TLM_JOB_TASK, ulStamp, (uint32_t)(uxDumpTask + 1));
+
+	if(uxDumpPart == 0)
+	{
+		Telemetry_add(&xWriter, TLM_JOB_COUNTER, ulStamp, JOB_STATS_COUNTER_VALUE(JOB_STATS_JOBS, xStats.uxJobs));
+		Telemetry_add(&xWriter, TLM_JOB_COUNTER, ulStamp, JOB_STATS_COUNTER_VALUE(JOB_STATS_CONTEXT_SWITCHES, xStats.uxContextSwitches));
+		Telemetry_add(&xWriter, TLM_JOB_COUNTER, ulStamp, JOB_STATS_COUNTER_VALUE(JOB_STATS_PREEMPTIONS, xStats.uxPreemptions));
+		Telemetry_add(&xWriter, TLM_JOB_COUNTER, ulStamp, JOB_STATS_COUNTER_VALUE(JOB_STATS_DEADLINE_MISSES, uxMisses));
+#if (configUSE_CPU_ACCOUNTING == 1)
+		Telemetry_add(&xWriter, TLM_CPU_BUCKET, ulStamp, JOB_STATS_CPU_BUCKET_VALUE(CPU_BUCKET_TASK, 0));
+		Telemetry_add(&xWriter, TLM_CPU_TIME, ulStamp, xStatus.ulRunTimeCounter);
+#endif
+	}
+	else
+	{
+		/* Empty buckets are left out */
+		for(uxBucket = 0; uxBucket < configJOB_STATS_BUCKETS; uxBucket++)
+		{
+			if(xStats.usHistogram[uxDumpPart - 1][uxBucket] != 0)
+			{
+				Telemetry_add(&xWriter, TLM_JOB_BUCKET, ulStamp, JOB_STATS_BUCKET_VALUE(uxDumpPart - 1, uxBucket, xStats.usHistogram[uxDumpPart - 1][uxBucket]));
+			}
+		}
+	}
+
+	usStatsFrameLength = Telemetry_end(&xWriter);
+}
+
+#if (configUSE_CPU_ACCOUNTING == 1)
+static void JobStats_cpuRecord(telemetryWriter_t * pxWriter, uint32_t ulStamp, cpuBucket_t eBucket, UBaseType_t uxIsr, uint32_t ulTime)
+{
+	Telemetry_add(pxWriter, TLM_CPU_BUCKET, ulStamp, JOB_STATS_CPU_BUCKET_VALUE(eBucket, uxIsr));
+	Telemetry_add(pxWriter, TLM_CPU_TIME, ulStamp, ulTime);
+}
+
+/* Last frame of a dump: the time that did not go to the task table */
+static void JobStats_cpuFrame(void)
+{
+	telemetryWriter_t xWriter;
+	uint32_t ulStamp = T1TC;
+	UBaseType_t uxIsr;
+
+	vTaskGetCpuAccounting(&xAccounting);
+
+	Telemetry_begin(&xWriter, TLM_STREAM_STATS, ucStatsFrame, sizeof(ucStatsFrame));
+	/* The idle task is only charged when it is switched out, so it lags while the dump runs */
+	JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_IDLE, 0, ulTaskGetIdleRunTimeCounter());
+	JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_SCHEDULER, 0, xAccounting.ulSchedulerTime);
+	JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_SWITCH, 0, xAccounting.ulSwitchTime);
+	JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_SWITCHES, 0, xAccounting.uxContextSwitches);
+	JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_TOTAL, 0, xAccounting.ulTotalTime);
+	for(uxIsr = 0; uxIsr < configACCOUNTING_ISRS; uxIsr++)
+	{
+		JobStats_cpuRecord(&xWriter, ulStamp, CPU_BUCKET_ISR, uxIsr, xAccounting.ulISRTime[uxIsr]);
+	}
+
+	usStatsFrameLength = Telemetry_end(&xWriter);
+}
+#endif
+
+#if (configUSE_CRITICAL_PROFILER == 1)
+/* One call site of a critical section or scheduler suspension, in xSite */
+static void JobStats_siteFrame(UBaseType_t uxSite)
+{
+	telemetryWriter_t xWriter;
+	uint32_t ulStamp = T1TC;
+	UBaseType_t uxBucket;
+
+	Telemetry_begin(&xWriter, TLM_STREAM_STATS, ucStatsFrame, sizeof(ucStatsFrame));
+	if(uxSite == 0)
+	{
+		Telemetry_add(&xWriter, TLM_SITE_DROPPED, ulStamp, uxCriticalProfilerGetDropped());
+	}
+	Telemetry_add(&xWriter, TLM_SITE, ulStamp, xSite.ulSite);
+	Telemetry_add(&xWriter, TLM_SITE_COUNT, ulStamp, xSite.ulCount);
+	Telemetry_add(&xWriter, TLM_SITE_MAX, ulStamp, xSite.ulMaxDuration);
+	for(uxBucket = 0; uxBucket < configCRITICAL_PROFILER_BUCKETS; uxBucket++)
+	{
+		if(xSite.usHistogram[uxBucket] != 0)
+		{
+			Telemetry_add(&xWriter, TLM_SITE_BUCKET, ulStamp, JOB_STATS_SITE_BUCKET_VALUE(uxBucket, xSite.usHistogram[uxBucket]));
+		}
+	}
+
+	usStatsFrameLength = Telemetry_end(&xWriter);
+}
+#endif
+
+/* Builds frame uxFrame of those sent after the task table, returns 0 once there are no more */
+static uint8_t JobStats_extraFrame(UBaseType_t uxFrame)
+{
+#if (configUSE_CPU_ACCOUNTING == 1)
+	if(uxFrame == 0)
+	{
+		JobStats_cpuFrame();
+		return 1;
+	}
+	uxFrame--;
+#endif
+
+#if (configUSE_CRITICAL_PROFILER == 1)
+	if(xCriticalProfilerGetSite(uxFrame, &xSite) == pdTRUE)
+	{
+		JobStats_siteFrame(uxFrame);
+		return 1;
+	}
+#endif
+
+	(void)uxFrame;
+	return 0;
+}
+
+/* Called from the idle hook: a JOB_STATS_COMMAND byte starts a dump, which then goes out a frame at a time */
+void JobStats_poll(const PeriodicTaskParameters_t * pxTaskTable, UBaseType_t uxTaskCount)
+{
+	signed char cCommand;
+	TaskHandle_t xTask;
+
+	if(ucDumping == 0)
+	{
+		if((xSerialGetChar(&cCommand) == pdFALSE) || (cCommand != JOB_STATS_COMMAND))
+		{
+			return;
+		}
+
+		ucDumping = 1;
+		uxDumpTask = 0;
+		uxDumpPart = 0;
+	}
+
+	/* A frame the UART had no room for is retried before the next one is built */
+	if(usStatsFrameLength == 0)
+	{
+		if(uxDumpTask < uxTaskCount)
+		{
+			if(uxDumpPart == 0)
+			{
+				xTask = *(pxTaskTable[uxDumpTask].pxCreatedTask);
+				vTaskGetJobStats(xTask, &xStats);
+				uxMisses = uxTaskGetDeadlineMisses(xTask);
+#if (configUSE_CPU_ACCOUNTING == 1)
+				vTaskGetInfo(xTask, &xStatus, pdFALSE, eInvalid);
+#endif
+			}
+
+			JobStats_frame();
+		}
+		else if(JobStats_extraFrame(uxDumpPart) == 0)
+		{
+			ucDumping = 0;
+			return;
+		}
+	}
+
+	if(vSerialPutString((signed char *)ucStatsFrame, usStatsFrameLength) == pdTRUE)
+	{
+		usStatsFrameLength = 0;
+
+		if((++uxDumpPart > tskJOB_HISTOGRAMS) && (uxDumpTask < uxTaskCount))
+		{
+			uxDumpPart = 0;
+			uxDumpTask++;
+		}
+	}
+}
@@ -0,0 +1,107 @@
+
+#include <stdint.h>
+#include <string.h>
+
+#define criticalFILE_ID		CRITICAL_FILE_LATENCY		/* Call sites in this file, see critical_profiler.h */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "latency.h"
+#include "lpc21xx.h"
+
+
+/* Running totals of one chain, averages are only divided out when read */
+typedef struct
+{
+	uint32_t ulCount;
+	uint32_t ulMin;
+	uint32_t ulMax;
+	uint64_t ullTotal;
+	uint64_t ullHopTotal[HOP_COUNT - 1];
+	uint32_t ulHopMax[HOP_COUNT - 1];
+	uint32_t ulHistogram[LATENCY_BIN_COUNT];
+
+}latencyAccumulator_t;
+
+static latencyAccumulator_t xChains[CHAIN_COUNT];
+
+void Latency_stamp(latencyStamps_t * pxStamps, latencyHop_t eHop)
+{
+	pxStamps->ulStamp[eHop] = T1TC;
+}
+
+/* Called by the sink once the message has left, from the tick interrupt when the UART frame is committed. Counts wrap with the timer */
+void Latency_record(latencyChain_t eChain, const latencyStamps_t * pxStamps)
+{
+	latencyAccumulator_t * pxChain = &xChains[eChain];
+	uint32_t ulLatency = pxStamps->ulStamp[HOP_SENT] - pxStamps->ulStamp[HOP_PRODUCED];
+	uint32_t ulHop, ulBin;
+	UBaseType_t uxSavedInterruptStatus;
+	uint8_t i;
+
+	ulBin = ulLatency >> LATENCY_BIN_SHIFT;
+	if(ulBin >= LATENCY_BIN_COUNT)
+	{
+		ulBin = LATENCY_BIN_COUNT - 1;
+	}
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		if((pxChain->ulCount == 0) || (ulLatency < pxChain->ulMin))
+		{
+			pxChain->ulMin = ulLatency;
+		}
+		if(ulLatency > pxChain->ulMax)
+		{
+			pxChain->ulMax = ulLatency;
+		}
+		pxChain->ulCount++;
+		pxChain->ullTotal += ulLatency;
+		pxChain->ulHistogram[ulBin]++;
+
+		for(i = 0; i < (HOP_COUNT - 1); i++)
+		{
+			ulHop = pxStamps->ulStamp[i + 1] - pxStamps->ulStamp[i];
+			pxChain->ullHopTotal[i] += ulHop;
+			if(ulHop > pxChain->ulHopMax[i])
+			{
+				pxChain->ulHopMax[i] = ulHop;
+			}
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR(uxSavedInterruptStatus);
+}
+
+void Latency_getStats(latencyChain_t eChain, latencyStats_t * pxStats)
+{
+	latencyAccumulator_t xChain;
+	uint8_t i;
+
+	/* Take a consistent copy, the divisions are done outside the critical section */
+	taskENTER_CRITICAL();
+	{
+		xChain = xChains[eChain];
+	}
+	taskEXIT_CRITICAL();
+
+	pxStats->ulCount = xChain.ulCount;
+	pxStats->ulMin = xChain.ulMin;
+	pxStats->ulMax = xChain.ulMax;
+	pxStats->ulAvg = (xChain.ulCount > 0) ? (uint32_t)(xChain.ullTotal / xChain.ulCount) : 0;
+
+	for(i = 0; i < (HOP_COUNT - 1); i++)
+	{
+		pxStats->ulHopAvg[i] = (xChain.ulCount > 0) ? (uint32_t)(xChain.ullHopTotal[i] / xChain.ulCount) : 0;
+		pxStats->ulHopMax[i] = xChain.ulHopMax[i];
+	}
+
+	memcpy(pxStats->ulHistogram, xChain.ulHistogram, sizeof(pxStats->ulHistogram));
+}
+
+void Latency_reset(latencyChain_t eChain)
+{
+	taskENTER_CRITICAL();
+	{
+		memset(&xChains[eChain], 0, sizeof(latencyAccumulator_t));
+	}
+	taskEXIT_CRITICAL();
+}
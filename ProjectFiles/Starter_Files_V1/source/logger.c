@@ -0,0 +1,122 @@
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "serial.h"
+#include "logger.h"
+#include "lpc21xx.h"
+
+
+#define LOG_INDEX_MASK					(LOG_RING_LENGTH - 1)
+#define LOG_FRAME_RECORDS				((uint16_t)8)
+
+/* The writer only moves ulHead and counts its own drops, the drain only moves ulTail, both wrap freely */
+typedef struct
+{
+	logRecord_t xRecords[LOG_RING_LENGTH];
+	volatile uint32_t ulHead;
+	volatile uint32_t ulTail;
+	volatile uint32_t ulLost;
+	uint32_t ulLostReported;				/* Drain side copy of ulLost */
+
+}logRing_t;
+
+static logRing_t xRings[LOG_SOURCE_COUNT];
+
+/* Frame being sent by the drain, kept until the UART takes it */
+static uint8_t ucLogFrame[TELEMETRY_FRAME_SIZE(0) + (LOG_FRAME_RECORDS * TELEMETRY_LOG_RECORD_MAX)];
+static uint16_t usLogFrameLength = 0;
+
+/* A handful of stores, no formatting, no locking: the record is filled in before it is published by moving the head */
+void Log_write(logSource_t eSource, logFormat_t eFormat, uint8_t ucArgCount, uint32_t ulArg0, uint32_t ulArg1, uint32_t ulArg2)
+{
+	logRing_t * pxRing = &xRings[eSource];
+	uint32_t ulHead = pxRing->ulHead;
+	logRecord_t * pxRecord;
+
+	if((ulHead - pxRing->ulTail) >= LOG_RING_LENGTH)
+	{
+		pxRing->ulLost++;
+		return;
+	}
+
+	pxRecord = &pxRing->xRecords[ulHead & LOG_INDEX_MASK];
+	pxRecord->ulStamp = T1TC;
+	pxRecord->usFormat = (uint16_t)eFormat;
+	pxRecord->ucArgCount = ucArgCount;
+	pxRecord->ulArgs[0] = ulArg0;
+	pxRecord->ulArgs[1] = ulArg1;
+	pxRecord->ulArgs[2] = ulArg2;
+
+	pxRing->ulHead = ulHead + 1;
+}
+
+/* Called from the idle hook: packs pending records into a log frame and hands it to the UART, formatting is left to the host */
+void Log_drain(void)
+{
+	telemetryWriter_t xWriter;
+	logRing_t * pxRing;
+	logRecord_t * pxRecord;
+	uint32_t ulLost, ulArgs[2];
+	uint8_t ucSource, ucAdded = 0, ucFull = 0, ucPending = 0;
+
+	for(ucSource = 0; ucSource < LOG_SOURCE_COUNT; ucSource++)
+	{
+		if((xRings[ucSource].ulHead != xRings[ucSource].ulTail) || (xRings[ucSource].ulLost != xRings[ucSource].ulLostReported))
+		{
+			ucPending = 1;
+		}
+	}
+
+	/* A frame the UART had no room for is retried before the next one is built, starting a frame uses up a sequence number */
+	if((usLogFrameLength == 0) && (ucPending != 0))
+	{
+		Telemetry_begin(&xWriter, TLM_STREAM_LOG, ucLogFrame, sizeof(ucLogFrame));
+
+		for(ucSource = 0; (ucSource < LOG_SOURCE_COUNT) && (ucFull == 0); ucSource++)
+		{
+			pxRing = &xRings[ucSource];
+
+			/* Drops are reported as a record of their own, ahead of what the source logged after them */
+			ulLost = pxRing->ulLost;
+			if(ulLost != pxRing->ulLostReported)
+			{
+				ulArgs[0] = ucSource;
+				ulArgs[1] = ulLost - pxRing->ulLostReported;
+				if(Telemetry_addLog(&xWriter, T1TC, LOG_RECORDS_LOST, 2, ulArgs) != 0)
+				{
+					pxRing->ulLostReported = ulLost;
+					ucAdded++;
+				}
+				else
+				{
+					ucFull = 1;
+				}
+			}
+
+			while((ucFull == 0) && (pxRing->ulHead != pxRing->ulTail))
+			{
+				pxRecord = &pxRing->xRecords[pxRing->ulTail & LOG_INDEX_MASK];
+				if(Telemetry_addLog(&xWriter, pxRecord->ulStamp, pxRecord->usFormat, pxRecord->ucArgCount, pxRecord->ulArgs) != 0)
+				{
+					pxRing->ulTail++;
+					ucAdded++;
+				}
+				else
+				{
+					ucFull = 1;
+				}
+			}
+		}
+
+		if(ucAdded > 0)
+		{
+			usLogFrameLength = Telemetry_end(&xWriter);
+		}
+	}
+
+	if((usLogFrameLength > 0) && (vSerialPutString((signed char *)ucLogFrame, usLogFrameLength) == pdTRUE))
+	{
+		usLogFrameLength = 0;
+	}
+}
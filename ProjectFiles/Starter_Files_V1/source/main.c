@@ -62,18 +62,50 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "mempool.h"
+#include "let.h"
 #include "lpc21xx.h"
 
 /* Peripheral includes. */
 #include "main.h"
 #include "serial.h"
 #include "GPIO.h"
+#include "latency.h"
+#include "logger.h"
+#include "trace_dump.h"
+#include "job_stats.h"
+#include "stack_report.h"
 
 
 													
 performanceEvaluation_t performanceEvaluation;
 QueueHandle_t xQueueConsumer;
-uint8_t i;
+
+/* Messages are passed to the consumer by reference, in blocks of this pool */
+mempoolDEFINE(xMessagePool, "Msg", sizeof(message_t), MESSAGE_POOL_SIZE);
+
+/* Stack and TCB of every task in the task table */
+#define TASK_STORAGE(func, name, period, deadline, budget, stack)				\
+					static StackType_t func##_Stack[stack];												\
+					static StaticTask_t func##_TCB;																\
+					static TaskHandle_t func##_Handle;
+
+#define TASK_PARAMETERS(func, name, period, deadline, budget, stack)		\
+					{func, name, period, deadline, budget, stack, (void *)NULL, func##_Stack, &func##_TCB, &func##_Handle},
+
+TASK_TABLE(TASK_STORAGE)
+
+static const PeriodicTaskParameters_t xTaskTable[NUMBER_OF_TASKS] = {
+	TASK_TABLE(TASK_PARAMETERS)
+};
+
+/* Frames Task_4 hands to the UART, written and committed without copies or locks */
+static uartFrame_t xUartFrames[letCHANNEL_SLOTS];
+static LetChannel_t xUartChannel;
+
+/* Stack and TCB of the idle task */
+static StackType_t xIdleTaskStack[configMINIMAL_STACK_SIZE];
+static StaticTask_t xIdleTaskTCB;
 
 													
 int main( void )
@@ -81,62 +113,18 @@ int main( void )
 	/* Setup the hardware for use with the Keil demo board. */
 	prvSetupHardware();
 
-	xQueueConsumer = xQueueCreate( QUEUE_LENGTH, sizeof( message_t ) );
+	/* Record the kernel events from the creation of the first task on, timer 1 must be running */
+	TraceDump_start();
 
-	xTaskPeriodicCreate(
-		Task_1, 
-		"Button_1_Monitor", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL,
-		(UBaseType_t) 0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_1);
-		
-	xTaskPeriodicCreate(
-		Task_2, 
-		"Button_2_Monitor", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL,
-		(UBaseType_t)0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_2);
-		
-	xTaskPeriodicCreate(
-		Task_3, 
-		"Periodic_Transmitter", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL,
-		(UBaseType_t)0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_3);
+	/* The consumer always gets the message with the earliest deadline, a full queue drops the latest one */
+	xQueueConsumer = xQueueCreateDeadlineOrdered( QUEUE_LENGTH, sizeof( message_t * ), queueOVERFLOW_EVICT_LATEST );
 
-		
-	xTaskPeriodicCreate(
-		Task_4, 
-		"Uart_Receiver", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL,
-		(UBaseType_t)0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_4);
-		
-	xTaskPeriodicCreate(
-		Task_5, 
-		"Load_1_Simulation", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL,
-		(UBaseType_t)0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_5);
-		
-	xTaskPeriodicCreate(
-		Task_6, 
-		"Load_2_Simulation", 
-		configMINIMAL_STACK_SIZE, 
-		(void *)NULL, 
-		(UBaseType_t) 0, 
-		(TaskHandle_t *)NULL, 
-		PERIODICITY_TASK_6);
+	/* Create all the periodic tasks in one pass, in memory reserved at link time */
+	xTaskPeriodicCreateTable(xTaskTable, NUMBER_OF_TASKS);
+
+	/* Task_4 runs in LET mode: its frame goes out at each of its deadlines, however early the job finished */
+	vLetChannelInitialise(&xUartChannel, xUartFrames, sizeof(uartFrame_t), Task_4_Handle, NULL, vUartFrameCommit);
+	vTaskSetLogicalExecution(Task_4_Handle);
 	
 	
 	/* Now all the tasks have been started - start the scheduler.
@@ -195,22 +183,38 @@ void vApplicationTickHook(void){
 
 void vApplicationIdleHook (void){
 	#if (PERFORMANCE_EVALUATION == 1)	
-		for(i=1; i<NUMBER_OF_TASKS+1; i++){
-			performanceEvaluation.temp += performanceEvaluation.taskTime[i].totalTime ;
+		TaskRunTimeWindow_t xIdleTime;
+	
+		/* The kernel keeps the idle time per window, so this only has to be read once a window */
+		vTaskGetRunTimeWindow(xTaskGetIdleTaskHandle(), RUN_TIME_WINDOW_CPU_LOAD, &xIdleTime);
+		if(xIdleTime.uxWindowNumber != performanceEvaluation.ulWindow){
+			performanceEvaluation.ulWindow = xIdleTime.uxWindowNumber;
+			performanceEvaluation.cpu_Load = tskUTILISATION_SCALE - xIdleTime.usUtilisation;
 		}
-		performanceEvaluation.cpu_Load = (performanceEvaluation.temp/ (float) T1TC) * 100;
-		performanceEvaluation.temp = 0;
 	#endif
+	
+	/* Log records are only packed and sent when nothing else needs the CPU */
+	Log_drain();
+	TraceDump_poll();
+	JobStats_poll(xTaskTable, NUMBER_OF_TASKS);
+	StackReport_poll(xTaskTable, NUMBER_OF_TASKS);
+}
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize){
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = xIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
 }
 /********************************************** Task 1 **********************/
 void Task_1(void *param){
 	TickType_t xLastWakeTime;
-	message_t xMessegeToSend = {0, 0};
+	message_t xMessegeToSend = {0};
 	bool sendMessege = false;
 	
 	pinState_t bCurrentButtonState, bPriviousButtonState = GPIO_read(PORT_1, PIN0);
 	buttonEdge_t buttonEdge;
 	
+	xMessegeToSend.eType = TLM_BUTTON_1_EDGE;
+	xMessegeToSend.eChain = CHAIN_BUTTON_1;
 	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t)1);
 	
 	xLastWakeTime = xTaskGetTickCount();
@@ -219,6 +223,7 @@ void Task_1(void *param){
 		//NOTE: This is bad practice and it definitely should be performed whitin the ISR with the EDGE detection hardware not in a task
 		bCurrentButtonState = GPIO_read(PORT_1, PIN0);
 		if(bCurrentButtonState != bPriviousButtonState){
+			Latency_stamp(&xMessegeToSend.xStamps, HOP_PRODUCED);
 			//start Critical Section
 			bPriviousButtonState = bCurrentButtonState;
 			if(bCurrentButtonState == PIN_IS_HIGH){
@@ -233,14 +238,12 @@ void Task_1(void *param){
 		
 		switch((int)buttonEdge){
 			case RISING:{
-					strcpy((char *)(xMessegeToSend.ucData), "Btn1 Rising detected");		
-					xMessegeToSend.ucData[MESSAGE_BUFFER_SIZE-1] = '\n';
+					xMessegeToSend.ulValue = 1;
 					sendMessege = true;
 				break;
 			}
 			case FALLING:{
-					strcpy((char *)(xMessegeToSend.ucData), "Btn1 Falling detected");		
-					xMessegeToSend.ucData[MESSAGE_BUFFER_SIZE-1] = '\n';
+					xMessegeToSend.ulValue = 0;
 					sendMessege = true;
 				break;
 			}
@@ -251,7 +254,7 @@ void Task_1(void *param){
 		}
 		
 		if(sendMessege == true){
-			xQueueSendToBack(xQueueConsumer, &xMessegeToSend, MAX_QUEUE_WAIT_TIME);
+			vSendMessage(&xMessegeToSend, MESSAGE_DEADLINE_BUTTON, LOG_SOURCE_BUTTON_1);
 		}
 		vTaskDelayUntil( &xLastWakeTime, PERIODICITY_TASK_1 );
 	}
@@ -260,12 +263,14 @@ void Task_1(void *param){
 ///********************************************** Task 2 **********************/
 void Task_2(void *param){
 	TickType_t xLastWakeTime;
-	message_t xMessegeToSend = {0, 0};
+	message_t xMessegeToSend = {0};
 	bool sendMessege = false;
 	
 	pinState_t bCurrentButtonState, bPriviousButtonState = GPIO_read(PORT_1, PIN1);
 	buttonEdge_t buttonEdge;
 	
+	xMessegeToSend.eType = TLM_BUTTON_2_EDGE;
+	xMessegeToSend.eChain = CHAIN_BUTTON_2;
 	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t)2);
 	
 	xLastWakeTime = xTaskGetTickCount();
@@ -274,6 +279,7 @@ void Task_2(void *param){
 		//NOTE: This is bad practice and it definitely should be performed whitin the ISR with the EDGE detection hardware not in a task
 		bCurrentButtonState = GPIO_read(PORT_1, PIN1);
 		if(bCurrentButtonState != bPriviousButtonState){
+			Latency_stamp(&xMessegeToSend.xStamps, HOP_PRODUCED);
 			//start Critical Section
 			bPriviousButtonState = bCurrentButtonState;
 			if(bCurrentButtonState == PIN_IS_HIGH){
@@ -288,14 +294,12 @@ void Task_2(void *param){
 		
 		switch((int)buttonEdge){
 			case RISING:{
-					strcpy((char *)(xMessegeToSend.ucData), "Btn2 Rising detected");		
-					xMessegeToSend.ucData[MESSAGE_BUFFER_SIZE-1] = '\n';
+					xMessegeToSend.ulValue = 1;
 					sendMessege = true;
 				break;
 			}
 			case FALLING:{
-					strcpy((char *)(xMessegeToSend.ucData), "Btn2 Falling detected");		
-					xMessegeToSend.ucData[MESSAGE_BUFFER_SIZE-1] = '\n';
+					xMessegeToSend.ulValue = 0;
 					sendMessege = true;
 				break;
 			}
@@ -306,7 +310,7 @@ void Task_2(void *param){
 		}
 		
 		if(sendMessege == true){
-			xQueueSendToBack(xQueueConsumer, &xMessegeToSend, MAX_QUEUE_WAIT_TIME);
+			vSendMessage(&xMessegeToSend, MESSAGE_DEADLINE_BUTTON, LOG_SOURCE_BUTTON_2);
 		}
 		vTaskDelayUntil( &xLastWakeTime, PERIODICITY_TASK_2);
 	}
@@ -315,18 +319,18 @@ void Task_2(void *param){
 /********************************************** Task 3 **********************/
 void Task_3(void *param){
 	TickType_t xLastWakeTime;
-	message_t xMessegeToSend = {0, 0};
-	xMessegeToSend.ucMessageID = '3';
+	message_t xMessegeToSend = {0};
+	xMessegeToSend.eType = TLM_PERIODIC_VALUE;
+	xMessegeToSend.eChain = CHAIN_PERIODIC;
 
 	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t)3);
 	
 	xLastWakeTime = xTaskGetTickCount();
 	for(;;){
-		vStringClear(xMessegeToSend.ucData);
-		vInt2String((uint32_t)(rand()%1024), xMessegeToSend.ucData);
-		xMessegeToSend.ucData[MESSAGE_BUFFER_SIZE-1] = '\n';
+		Latency_stamp(&xMessegeToSend.xStamps, HOP_PRODUCED);
+		xMessegeToSend.ulValue = (uint32_t)(rand()%1024);
 		
-		xQueueSendToBack(xQueueConsumer, &xMessegeToSend, MAX_QUEUE_WAIT_TIME);
+		vSendMessage(&xMessegeToSend, MESSAGE_DEADLINE_PERIODIC, LOG_SOURCE_PERIODIC);
 		vTaskDelayUntil( &xLastWakeTime, PERIODICITY_TASK_3 );
 	}
 }
@@ -336,7 +340,10 @@ void Task_3(void *param){
 /********************************************** Task 4 **********************/
 void Task_4(void *param){
 	TickType_t xLastWakeTime;
-	message_t xMessageBuffer;
+	message_t * pxMessages[CONSUMER_BATCH_SIZE];
+	uartFrame_t * pxFrame;
+	telemetryWriter_t xWriter;
+	UBaseType_t uxCount, uxIndex;
 	
 	
 	vTaskSetApplicationTaskTag(NULL, (TaskHookFunction_t)4);
@@ -344,13 +351,33 @@ void Task_4(void *param){
 	xLastWakeTime = xTaskGetTickCount();
 	for(;;){
 
-			if( xQueueReceive( xQueueConsumer,
-                         &( xMessageBuffer ),
-                         ( TickType_t ) MAX_QUEUE_WAIT_TIME) == pdPASS )
-      {
-         vSerialPutString((signed char *)(xMessageBuffer.ucData), MESSAGE_BUFFER_SIZE);
-      }
+			/* Drain up to a batch of messages per period into this period's telemetry frame */
+			pxFrame = (uartFrame_t *)pvLetChannelWriteBuffer(&xUartChannel);
+			uxCount = uxQueueReceiveMultiple( xQueueConsumer,
+                                        pxMessages,
+                                        CONSUMER_BATCH_SIZE,
+                                        ( TickType_t ) MAX_QUEUE_WAIT_TIME);
 			
+			if(uxCount > 0)
+			{
+				Telemetry_begin(&xWriter, TLM_STREAM_EVENTS, pxFrame->ucData, sizeof(pxFrame->ucData));
+			}
+			for(uxIndex = 0; uxIndex < uxCount; uxIndex++)
+			{
+				Latency_stamp(&pxMessages[uxIndex]->xStamps, HOP_DEQUEUED);
+				(void)Telemetry_add(&xWriter, pxMessages[uxIndex]->eType, pxMessages[uxIndex]->xStamps.ulStamp[HOP_PRODUCED], pxMessages[uxIndex]->ulValue);
+				pxFrame->xStamps[uxIndex] = pxMessages[uxIndex]->xStamps;
+				pxFrame->eChains[uxIndex] = pxMessages[uxIndex]->eChain;
+				vMemPoolFree(&xMessagePool, pxMessages[uxIndex]);
+			}
+			pxFrame->ucCount = (uint8_t)uxCount;
+			pxFrame->usLength = (uxCount > 0) ? Telemetry_end(&xWriter) : 0;
+			
+			if((uxCount == CONSUMER_BATCH_SIZE) && (uxQueueMessagesWaiting(xQueueConsumer) > 0)){
+				LOG1(LOG_SOURCE_CONSUMER, LOG_CONSUMER_BACKLOG, uxQueueMessagesWaiting(xQueueConsumer));
+			}
+			
+			/* The kernel commits the frame at the deadline, any deadline inherited from the batch is dropped when the job ends below */
 		vTaskDelayUntil( &xLastWakeTime, PERIODICITY_TASK_4);
 	}
 }
@@ -381,37 +408,47 @@ void Task_6(void *param){
 	}
 }
 
-void vStringClear(char * inOutString){
-	char * temp;
-	for(i=0; i<MESSAGE_BUFFER_SIZE ; i++){
-		temp = inOutString + i;
-		 if(* temp == 0){
-			 break;
-		 }else{ 
-				*temp = 0;
-		 }
-	 }
-}
-void vInt2String (uint32_t inInteger, char * outString){
-	uint8_t outLocalString[MESSAGE_BUFFER_SIZE] = {0};
-
-	uint8_t stringSize, i = 0;
-	//ASSERT(MESSAGE_BUFFER_SIZE < 10);
+/* Called from the tick interrupt at each deadline of Task_4 with the frame it completed */
+void vUartFrameCommit(void * pvFrame){
+	uartFrame_t * pxFrame = (uartFrame_t *)pvFrame;
+	uint8_t ucIndex;
 	
-	if(inInteger == 0){
-		*(outString) = TO_ASCII(0);
-	}else{
-		while(inInteger > 0){
-			outLocalString[i] = (uint8_t)(TO_ASCII(inInteger%10));
-			inInteger /= 10;
-			i++;
+	if(pxFrame->ucCount == 0){
+		return;
+	}
+	
+	/* Only messages the UART accepted count towards their chain latency */
+	if(xSerialPutStringFromISR((signed char *)pxFrame->ucData, pxFrame->usLength) == pdTRUE){
+		for(ucIndex = 0; ucIndex < pxFrame->ucCount; ucIndex++){
+			Latency_stamp(&pxFrame->xStamps[ucIndex], HOP_SENT);
+			Latency_record(pxFrame->eChains[ucIndex], &pxFrame->xStamps[ucIndex]);
 		}
+	}else{
+		LOG2(LOG_SOURCE_ISR, LOG_UART_FRAME_DROPPED, pxFrame->usLength, pxFrame->ucCount);
+	}
+}
 
-		stringSize = strlen((const char *)outLocalString);
-
-		for(i=0; i<stringSize; i++){
-			*(outString + (stringSize-1-i)) = outLocalString[i];
+/* Copy a message into a pool block and queue a reference to it for the consumer, due ulRelativeDeadline ticks from now. Losses are logged on eSource */
+void vSendMessage(const message_t * pxMessage, uint32_t ulRelativeDeadline, logSource_t eSource){
+	message_t * pxBlock = (message_t *)pvMemPoolAlloc(&xMessagePool);
+	message_t * pxEvicted;
+	
+	if(pxBlock != NULL){
+		*pxBlock = *pxMessage;
+		Latency_stamp(&pxBlock->xStamps, HOP_QUEUED);
+		switch(xQueueSendWithDeadline(xQueueConsumer, &pxBlock, xTaskGetTickCount() + ulRelativeDeadline, &pxEvicted, MAX_QUEUE_WAIT_TIME)){
+			case queueITEM_EVICTED:
+				LOG1(eSource, LOG_MESSAGE_EVICTED, pxEvicted->eChain);
+				vMemPoolFree(&xMessagePool, pxEvicted);
+				break;
+			case pdPASS:
+				break;
+			default:
+				LOG1(eSource, LOG_MESSAGE_DROPPED, pxMessage->eChain);
+				vMemPoolFree(&xMessagePool, pxBlock);
+				break;
 		}
+	}else{
+		LOG1(eSource, LOG_MESSAGE_DROPPED, pxMessage->eChain);
 	}
-	 
 }
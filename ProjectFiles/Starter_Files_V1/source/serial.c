@@ -27,19 +27,29 @@
 
 
 /* 
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0. 
+	INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART1. 
 
-	Note this driver is used to test the FreeRTOS port.  It is NOT intended to
-	be an example of an efficient implementation!
+	Transmitted strings are queued in a stream buffer that the UART interrupt
+	drains through the 16 byte transmit FIFO, so any number of tasks (and the
+	tick interrupt) can write without waiting for the previous string to go out.
+	A string is either queued whole or dropped whole, and the drops are counted.
+
+	Received bytes go into a ring buffer with the interrupt as the only writer
+	and one task as the only reader.  Each side only ever moves its own index,
+	so neither needs a critical section.
 */
 
 /* Standard includes. */
 #include <stdlib.h>
 
+/* Call sites in this file, see critical_profiler.h. */
+#define criticalFILE_ID		CRITICAL_FILE_SERIAL
+
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "queue.h"
 #include "task.h"
+#include "stream_buffer.h"
 
 /* Demo application includes. */
 #include "serial.h"
@@ -58,6 +68,7 @@
 #define ser8_BIT_CHARS					( ( unsigned char ) 0x03 )
 #define serFIFO_ON						( ( unsigned char ) 0x01 )
 #define serCLEAR_FIFO					( ( unsigned char ) 0x06 )
+#define serRX_TRIGGER_8					( ( unsigned char ) 0x80 )	/* Interrupt every 8 bytes, the RX timeout picks up the rest. */
 #define serWANTED_CLOCK_SCALING			( ( unsigned long ) 16 )
 
 /* Constants to setup and access the VIC. */
@@ -76,13 +87,63 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* Line status bits. */
+#define serLSR_RX_DATA_READY			( ( unsigned char ) 0x01 )
+#define serLSR_OVERRUN					( ( unsigned char ) 0x02 )
+
+/* Constants for the transmit path. */
+#define serTX_BUFFER_SIZE				( ( size_t ) 256 )		/* Over 20ms of output at 115200 baud. */
+#define serTX_FIFO_DEPTH				( ( size_t ) 16 )		/* The FIFO is empty whenever THRE is signalled. */
+#define serTX_MAX_WAITERS				( ( unsigned char ) 4 )	/* Tasks that can wait for space at once. */
+
+/* Size of the receive ring, can be set in FreeRTOSConfig.h.  Must be a power
+of two so the free running indexes can be masked and wrap cleanly. */
+#ifndef serRX_BUFFER_SIZE
+	#define serRX_BUFFER_SIZE			128
+#endif
+
+#if ( ( serRX_BUFFER_SIZE & ( serRX_BUFFER_SIZE - 1 ) ) != 0 ) || ( serRX_BUFFER_SIZE > 65536 )
+	#error serRX_BUFFER_SIZE must be a power of two no larger than 65536
+#endif
+
+#define serRX_INDEX_MASK				( ( unsigned long ) ( serRX_BUFFER_SIZE - 1 ) )
+
 /*-----------------------------------------------------------*/
-unsigned char receivedChar;
-unsigned char isNewCharAvailable = 0;
 
-unsigned char txBuffer[200];
-unsigned char txDataSizeToSend;
-unsigned char txDataSizeLeftToSend;
+/* Received bytes.  ulRxHead is only written by the interrupt and ulRxTail
+only by the reading task, both count bytes since start up and are masked
+when indexing, so the ring is full when they are serRX_BUFFER_SIZE apart. */
+static unsigned char ucRxBuffer[ serRX_BUFFER_SIZE ];
+static volatile unsigned long ulRxHead = 0;
+static volatile unsigned long ulRxTail = 0;
+
+/* The task blocked in xSerialGetCharWait(), if any. */
+static volatile TaskHandle_t xRxWaiter = NULL;
+
+/* Only written by the interrupt. */
+static xSerialRxStats xRxStats;
+
+/* Bytes waiting to go out.  The UART interrupt is the only reader, writers
+are serialised by disabling interrupts. */
+static StreamBufferHandle_t xTxStream = NULL;
+static StaticStreamBuffer_t xTxStreamStruct;
+static uint8_t ucTxStreamStorage[ serTX_BUFFER_SIZE + 1 ];
+
+/* pdTRUE when the transmitter has run dry, so the next write has to prime
+the FIFO itself as no THRE interrupt is going to come. */
+static volatile BaseType_t xTxIdle = pdTRUE;
+
+/* Tasks blocked in xSerialPutStringWait(), and the space each one needs. */
+typedef struct
+{
+	TaskHandle_t xTask;
+	size_t xSpaceNeeded;
+} xTxWaiter;
+
+static xTxWaiter xTxWaiters[ serTX_MAX_WAITERS ];
+
+static xSerialTxStats xTxStats;
+
 /*
  * The asm wrapper for the interrupt service routine.
  */
@@ -93,11 +154,32 @@ extern void vUART_ISREntry( void );
  */
 void vUART_ISRHandler( void );
 
+/*
+ * Move up to a FIFO worth of bytes from the stream buffer to the UART.  Must
+ * be called with interrupts disabled.
+ */
+static void prvTxFill( void );
+
+/*
+ * Move everything in the receive FIFO to the ring buffer.  Only called from
+ * the interrupt.
+ */
+static void prvRxDrain( void );
+
+/*
+ * Queue the whole string, or nothing if it does not fit.  Must be called
+ * with interrupts disabled.
+ */
+static BaseType_t prvTxWrite( const signed char * const pcString, size_t xLength );
+
 /*-----------------------------------------------------------*/
 
 void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 {
     unsigned long ulDivisor, ulWantedClock;
+
+	/* Create the transmit buffer before the interrupt can use it. */
+	xTxStream = xStreamBufferCreateStatic( sizeof( ucTxStreamStorage ), 1, ucTxStreamStorage, &xTxStreamStruct );
 	
 	/* Configure the UART1 pins.  All other pins remain at their default of 0. */
 	PINSEL0 |= mainTX_ENABLE;
@@ -116,7 +198,7 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 	U1DLM = ( unsigned char ) ( ulDivisor & ( unsigned long ) 0xff );
 
 	/* Turn on the FIFO's and clear the buffers. */
-	U1FCR = ( serFIFO_ON | serCLEAR_FIFO );
+	U1FCR = ( serFIFO_ON | serCLEAR_FIFO | serRX_TRIGGER_8 );
 
 	/* Setup transmission format. */
 	U1LCR = serNO_PARITY | ser1_STOP_BIT | ser8_BIT_CHARS;
@@ -134,12 +216,16 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
 {
+unsigned long ulTail = ulRxTail;
+
 	/* Get the next character from the buffer.  Return false if no characters
-	are available, or arrive before xBlockTime expires. */
-	if(isNewCharAvailable == 1U)
+	are available. */
+	if( ulRxHead != ulTail )
 	{
-		isNewCharAvailable = 0U;
-		*pcRxedChar = receivedChar;
+		*pcRxedChar = ( signed char ) ucRxBuffer[ ulTail & serRX_INDEX_MASK ];
+
+		/* Only release the slot once the byte has been read out of it. */
+		ulRxTail = ulTail + 1;
 		return pdTRUE;
 	}
 	else
@@ -149,86 +235,327 @@ signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+signed portBASE_TYPE xSerialGetCharWait(signed char *pcRxedChar, TickType_t xTicksToWait )
 {
-	int i;
+TimeOut_t xTimeOut;
 
-	if(txDataSizeLeftToSend == 0 && pcString != NULL)
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
 	{
-	  txDataSizeToSend = usStringLength;
-	  txDataSizeLeftToSend = usStringLength;
-	
-	  for(i = 0;i < usStringLength; i++)
-	  {
-		  txBuffer[i] = pcString[i];
-	  }
-	
-	  xSerialPutChar(txBuffer[txDataSizeToSend - txDataSizeLeftToSend--]);
-		
-	  return pdTRUE;
+		if( xSerialGetChar( pcRxedChar ) == pdTRUE )
+		{
+			return pdTRUE;
+		}
+
+		if( xTicksToWait == ( TickType_t ) 0 )
+		{
+			return pdFALSE;
+		}
+
+		/* Register before looking again, so a byte that arrives in between
+		leaves a notification pending rather than being missed. */
+		configASSERT( ( xRxWaiter == NULL ) || ( xRxWaiter == xTaskGetCurrentTaskHandle() ) );
+		xRxWaiter = xTaskGetCurrentTaskHandle();
+
+		if( ulRxHead == ulRxTail )
+		{
+			( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+		}
+
+		xRxWaiter = NULL;
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+		{
+			/* One last look before giving up. */
+			xTicksToWait = 0;
+		}
 	}
-	else
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTxWrite( const signed char * const pcString, size_t xLength )
+{
+size_t xUsed;
+
+	if( ( pcString == NULL ) || ( xStreamBufferSpacesAvailable( xTxStream ) < xLength ) )
 	{
+		xTxStats.ulStringsDropped++;
+		xTxStats.ulBytesDropped += xLength;
 		return pdFALSE;
 	}
+
+	/* The FromISR send is used from tasks too as it does not suspend the
+	scheduler, interrupts are already disabled by the caller. */
+	( void ) xStreamBufferSendFromISR( xTxStream, pcString, xLength, NULL );
+	xTxStats.ulBytesQueued += xLength;
+
+	xUsed = xStreamBufferBytesAvailable( xTxStream );
+	if( xUsed > xTxStats.ulHighWaterMark )
+	{
+		xTxStats.ulHighWaterMark = xUsed;
+	}
+
+	if( xTxIdle == pdTRUE )
+	{
+		prvTxFill();
+	}
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+{
+BaseType_t xReturn;
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvTxWrite( pcString, usStringLength );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPutStringFromISR(const signed char * const pcString, unsigned short usStringLength )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		xReturn = prvTxWrite( pcString, usStringLength );
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE xSerialPutStringWait(const signed char * const pcString, unsigned short usStringLength, TickType_t xTicksToWait )
+{
+BaseType_t xReturn = pdFALSE, xWaiting;
+TimeOut_t xTimeOut;
+unsigned char ucSlot = 0;
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		xWaiting = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			if( ( pcString == NULL ) || ( usStringLength > serTX_BUFFER_SIZE ) ||
+				( xStreamBufferSpacesAvailable( xTxStream ) >= usStringLength ) ||
+				( xTicksToWait == ( TickType_t ) 0 ) )
+			{
+				/* Either fits now or never will, the write counts a drop. */
+				xReturn = prvTxWrite( pcString, usStringLength );
+			}
+			else
+			{
+				/* Ask the interrupt to wake this task once enough has gone out. */
+				for( ucSlot = 0; ucSlot < serTX_MAX_WAITERS; ucSlot++ )
+				{
+					if( xTxWaiters[ ucSlot ].xTask == NULL )
+					{
+						/* Discard any stale notification before waiting for a new one. */
+						( void ) ulTaskNotifyTake( pdTRUE, 0 );
+						xTxWaiters[ ucSlot ].xTask = xTaskGetCurrentTaskHandle();
+						xTxWaiters[ ucSlot ].xSpaceNeeded = usStringLength;
+						xWaiting = pdTRUE;
+						break;
+					}
+				}
+
+				if( xWaiting == pdFALSE )
+				{
+					/* Too many writers are already waiting. */
+					xReturn = prvTxWrite( pcString, usStringLength );
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xWaiting == pdFALSE )
+		{
+			break;
+		}
+
+		( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+
+		taskENTER_CRITICAL();
+		{
+			/* The interrupt frees the slot when it gives the notification. */
+			if( xTxWaiters[ ucSlot ].xTask == xTaskGetCurrentTaskHandle() )
+			{
+				xTxWaiters[ ucSlot ].xTask = NULL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdTRUE )
+		{
+			/* Last attempt, which counts the drop if there is still no room. */
+			xTicksToWait = 0;
+		}
+	}
+
+	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
 void xSerialPutChar(signed char cOutChar)
 {
-	U1THR = cOutChar;
+	( void ) vSerialPutString( &cOutChar, 1 );
+}
+/*-----------------------------------------------------------*/
+
+void vSerialGetTxStats( xSerialTxStats *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xTxStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vSerialGetRxStats( xSerialRxStats *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xRxStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTxFill( void )
+{
+uint8_t ucChunk[ serTX_FIFO_DEPTH ];
+size_t xCount, x;
+
+	xCount = xStreamBufferReceiveFromISR( xTxStream, ucChunk, serTX_FIFO_DEPTH, NULL );
+
+	for( x = 0; x < xCount; x++ )
+	{
+		U1THR = ucChunk[ x ];
+	}
+
+	/* With nothing written there will be no further THRE interrupt. */
+	xTxIdle = ( xCount == 0 ) ? pdTRUE : pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-//void vUART_ISRHandler( void )
-//{
-//signed char cChar;
-//unsigned char ucInterrupt;
-
-//	ucInterrupt = U1IIR;
-
-//	/* The interrupt pending bit is active low. */
-//	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
-//	{
-//		/* What caused the interrupt? */
-//		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
-//		{
-//			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
-//				cChar = U1LSR;
-//				break;
-//	
-//			case serSOURCE_THRE	:	/* The THRE is empty */
-//				
-//				/* Do nothing */
-//				if(txDataSizeLeftToSend > 0)
-//				{
-//					U1THR = txBuffer[txDataSizeToSend - txDataSizeLeftToSend--];
-//				}
-//				
-//				break;
-//	
-//			case serSOURCE_RX_TIMEOUT :
-//			case serSOURCE_RX	:	/* A character was received */
-//			
-//				receivedChar = U1RBR;
-//				isNewCharAvailable = 1U;			
-//				break;
-//	
-//			default:	/* There is nothing to do, leave the ISR. */
-//				break;
-//		}
-
-//		ucInterrupt = U1IIR;
-//	}
-
-//	/* Clear the ISR in the VIC. */
-//	VICVectAddr = serCLEAR_VIC_INTERRUPT;
-//}
-///*-----------------------------------------------------------*/
+static void prvRxDrain( void )
+{
+unsigned long ulHead = ulRxHead, ulUsed;
+unsigned char ucStatus, ucChar;
 
+	ucStatus = U1LSR;
 
+	if( ( ucStatus & serLSR_OVERRUN ) != 0 )
+	{
+		/* The FIFO filled before the interrupt was serviced. */
+		xRxStats.ulHardwareOverruns++;
+	}
 
+	while( ( ucStatus & serLSR_RX_DATA_READY ) != 0 )
+	{
+		ucChar = U1RBR;
+
+		if( ( ulHead - ulRxTail ) < serRX_BUFFER_SIZE )
+		{
+			ucRxBuffer[ ulHead & serRX_INDEX_MASK ] = ucChar;
+			ulHead++;
+			xRxStats.ulBytesReceived++;
+		}
+		else
+		{
+			/* The reader has fallen behind, drop the new byte. */
+			xRxStats.ulOverruns++;
+		}
+
+		ucStatus = U1LSR;
+	}
 
+	/* Publish the bytes only after they have been stored. */
+	ulRxHead = ulHead;
 
+	ulUsed = ulHead - ulRxTail;
+	if( ulUsed > xRxStats.ulHighWaterMark )
+	{
+		xRxStats.ulHighWaterMark = ulUsed;
+	}
+}
+/*-----------------------------------------------------------*/
 
+void vUART_ISRHandler( void )
+{
+signed char cChar;
+unsigned char ucInterrupt, ucSlot;
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+size_t xSpace;
+
+	traceISR_ENTER( ACCOUNTING_ISR_UART );
+
+	ucInterrupt = U1IIR;
+
+	/* The interrupt pending bit is active low. */
+	while( ( ucInterrupt & serINTERRUPT_IS_PENDING ) == 0 )
+	{
+		/* What caused the interrupt? */
+		switch( ucInterrupt & serINTERRUPT_SOURCE_MASK )
+		{
+			case serSOURCE_ERROR :	/* Not handling this, but clear the interrupt. */
+				cChar = U1LSR;
+				break;
+	
+			case serSOURCE_THRE	:	/* The FIFO is empty, refill it. */
+				
+				prvTxFill();
+
+				xSpace = xStreamBufferSpacesAvailable( xTxStream );
+				for( ucSlot = 0; ucSlot < serTX_MAX_WAITERS; ucSlot++ )
+				{
+					if( ( xTxWaiters[ ucSlot ].xTask != NULL ) && ( xTxWaiters[ ucSlot ].xSpaceNeeded <= xSpace ) )
+					{
+						vTaskNotifyGiveFromISR( xTxWaiters[ ucSlot ].xTask, &xHigherPriorityTaskWoken );
+						xTxWaiters[ ucSlot ].xTask = NULL;
+					}
+				}
+				break;
+	
+			case serSOURCE_RX_TIMEOUT :
+			case serSOURCE_RX	:	/* Characters were received */
+			
+				prvRxDrain();
+
+				if( ( xRxWaiter != NULL ) && ( ulRxHead != ulRxTail ) )
+				{
+					vTaskNotifyGiveFromISR( xRxWaiter, &xHigherPriorityTaskWoken );
+					xRxWaiter = NULL;
+				}
+				break;
 	
+			default:	/* There is nothing to do, leave the ISR. */
+				break;
+		}
+
+		ucInterrupt = U1IIR;
+	}
+
+	/* Switch to a reader or writer that was woken if it should run now. */
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
+
+	traceISR_EXIT();
+
+	/* Clear the ISR in the VIC. */
+	VICVectAddr = serCLEAR_VIC_INTERRUPT;
+	( void ) cChar;
+}
+/*-----------------------------------------------------------*/
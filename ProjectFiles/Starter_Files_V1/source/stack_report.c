@@ -0,0 +1,49 @@
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "logger.h"
+#include "stack_report.h"
+
+
+/* Task being sampled: a task table entry, or uxTaskCount for the idle task */
+static UBaseType_t uxSampleTask = 0;
+
+/* Recommendation last logged per task, a new one is logged each time a pass finds deeper use */
+static configSTACK_DEPTH_TYPE usLoggedDepth[STACK_REPORT_TASKS_MAX];
+
+/* Called from the idle hook: samples the stacks a few words at a time, one task after the other */
+void StackReport_poll(const PeriodicTaskParameters_t * pxTaskTable, UBaseType_t uxTaskCount)
+{
+	TaskHandle_t xTask;
+	TaskStackReport_t xReport;
+
+	configASSERT(uxTaskCount < STACK_REPORT_TASKS_MAX);
+
+	if(uxSampleTask < uxTaskCount)
+	{
+		xTask = *(pxTaskTable[uxSampleTask].pxCreatedTask);
+	}
+	else
+	{
+		xTask = xTaskGetIdleTaskHandle();
+	}
+
+	if(xTaskStackWatermarkStep(xTask, STACK_REPORT_WORDS_PER_POLL) == pdFALSE)
+	{
+		return;
+	}
+
+	vTaskGetStackReport(xTask, &xReport);
+	if(xReport.uxRecommendedDepth != usLoggedDepth[uxSampleTask])
+	{
+		usLoggedDepth[uxSampleTask] = xReport.uxRecommendedDepth;
+		/* Tasks are numbered from 1 in task table order, then idle, as in the kernel trace */
+		LOG3(LOG_SOURCE_IDLE, LOG_STACK_REPORT, uxSampleTask + 1, xReport.uxStackUsed, xReport.uxRecommendedDepth);
+	}
+
+	if(++uxSampleTask > uxTaskCount)
+	{
+		uxSampleTask = 0;
+	}
+}
@@ -0,0 +1,114 @@
+
+#include <stdint.h>
+#include "telemetry.h"
+
+
+/* Each stream is only built by one task */
+static uint8_t ucSequence[TLM_STREAM_COUNT];
+
+/* COBS: every zero is replaced by the distance to the next one, kept in the code byte that starts each block */
+static void prvPutByte(telemetryWriter_t * pxWriter, uint8_t ucByte)
+{
+	if(ucByte != 0)
+	{
+		pxWriter->pucBuffer[pxWriter->usLength++] = ucByte;
+		pxWriter->ucCode++;
+	}
+
+	/* A zero ends the block, so does a block of 254 non zero bytes */
+	if((ucByte == 0) || (pxWriter->ucCode == 0xFF))
+	{
+		pxWriter->pucBuffer[pxWriter->usCodeIndex] = pxWriter->ucCode;
+		pxWriter->usCodeIndex = pxWriter->usLength++;
+		pxWriter->ucCode = 1;
+	}
+}
+
+static void prvPutVarint(telemetryWriter_t * pxWriter, uint32_t ulValue)
+{
+	while(ulValue >= 0x80)
+	{
+		prvPutByte(pxWriter, (uint8_t)(ulValue | 0x80));
+		ulValue >>= 7;
+	}
+	prvPutByte(pxWriter, (uint8_t)ulValue);
+}
+
+/* Whether a record of up to usRecordMax bytes, a code byte it may start and the delimiter still fit */
+static uint8_t prvHasRoom(const telemetryWriter_t * pxWriter, uint16_t usRecordMax)
+{
+	uint16_t usNeeded = usRecordMax + 1;
+
+	if((pxWriter->ucCode + usRecordMax) >= 0xFF)
+	{
+		usNeeded++;
+	}
+
+	return ((pxWriter->usCapacity - pxWriter->usLength) >= usNeeded) ? 1 : 0;
+}
+
+static void prvPutHeader(telemetryWriter_t * pxWriter, telemetryType_t eType, uint32_t ulStamp, uint32_t ulValue)
+{
+	int32_t lDelta;
+
+	/* Records are in deadline order rather than time order, so the delta can be negative */
+	lDelta = (int32_t)(ulStamp - pxWriter->ulLastStamp);
+	pxWriter->ulLastStamp = ulStamp;
+
+	prvPutByte(pxWriter, (uint8_t)eType);
+	prvPutVarint(pxWriter, ((uint32_t)lDelta << 1) ^ (uint32_t)(lDelta >> 31));
+	prvPutVarint(pxWriter, ulValue);
+}
+
+void Telemetry_begin(telemetryWriter_t * pxWriter, telemetryStream_t eStream, uint8_t * pucBuffer, uint16_t usCapacity)
+{
+	pxWriter->pucBuffer = pucBuffer;
+	pxWriter->usCapacity = usCapacity;
+	pxWriter->usCodeIndex = 0;
+	pxWriter->usLength = 1;
+	pxWriter->ucCode = 1;
+	pxWriter->ulLastStamp = 0;
+
+	prvPutByte(pxWriter, (uint8_t)((eStream << 6) | (ucSequence[eStream]++ & TELEMETRY_SEQUENCE_MASK)));
+}
+
+/* Returns 0 and leaves the frame as it was if the record might not fit */
+uint8_t Telemetry_add(telemetryWriter_t * pxWriter, telemetryType_t eType, uint32_t ulStamp, uint32_t ulValue)
+{
+	if(prvHasRoom(pxWriter, TELEMETRY_RECORD_MAX) == 0)
+	{
+		return 0;
+	}
+
+	prvPutHeader(pxWriter, eType, ulStamp, ulValue);
+
+	return 1;
+}
+
+/* A log record is left for the host to format, it only carries the format ID and the raw argument words */
+uint8_t Telemetry_addLog(telemetryWriter_t * pxWriter, uint32_t ulStamp, uint16_t usFormat, uint8_t ucArgCount, const uint32_t * pulArgs)
+{
+	uint8_t i;
+
+	if((ucArgCount > TELEMETRY_LOG_ARGS_MAX) || (prvHasRoom(pxWriter, TELEMETRY_LOG_RECORD_MAX) == 0))
+	{
+		return 0;
+	}
+
+	prvPutHeader(pxWriter, TLM_LOG, ulStamp, ((uint32_t)usFormat << 2) | ucArgCount);
+	for(i = 0; i < ucArgCount; i++)
+	{
+		prvPutVarint(pxWriter, pulArgs[i]);
+	}
+
+	return 1;
+}
+
+/* Closes the last block and appends the delimiter, returns the bytes to send */
+uint16_t Telemetry_end(telemetryWriter_t * pxWriter)
+{
+	pxWriter->pucBuffer[pxWriter->usCodeIndex] = pxWriter->ucCode;
+	pxWriter->pucBuffer[pxWriter->usLength++] = TELEMETRY_DELIMITER;
+
+	return pxWriter->usLength;
+}
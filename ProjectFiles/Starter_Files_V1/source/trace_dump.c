@@ -0,0 +1,68 @@
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "serial.h"
+#include "trace_dump.h"
+#include "lpc21xx.h"
+
+
+/* Frame being sent, kept until the UART takes it */
+static uint8_t ucTraceFrame[TELEMETRY_FRAME_SIZE(TRACE_DUMP_FRAME_EVENTS + 1)];
+static uint16_t usTraceFrameLength = 0;
+
+/* Events of the stopped recording already framed, and how many it holds */
+static UBaseType_t uxDumpNext = 0;
+static UBaseType_t uxDumpCount = 0;
+
+void TraceDump_start(void)
+{
+	uxDumpNext = 0;
+	uxDumpCount = 0;
+	vTraceStart(TRACE_DUMP_MODE);
+}
+
+/* Called from the idle hook: once the recorder stops, its events go out a frame at a time, then it is started again */
+void TraceDump_poll(void)
+{
+	telemetryWriter_t xWriter;
+	TraceEvent_t xEvent;
+	uint16_t usAdded = 0;
+
+	if(xTraceIsStopped() == pdFALSE)
+	{
+		return;
+	}
+
+	/* A frame the UART had no room for is retried before the next one is built */
+	if(usTraceFrameLength == 0)
+	{
+		Telemetry_begin(&xWriter, TLM_STREAM_TRACE, ucTraceFrame, sizeof(ucTraceFrame));
+
+		/* The first frame of a dump says how many events follow, so the host knows where a dump starts and if it is whole */
+		if(uxDumpNext == 0)
+		{
+			uxDumpCount = uxTraceGetEventCount();
+			Telemetry_add(&xWriter, TLM_TRACE_DUMP, T1TC, (uint32_t)uxDumpCount);
+		}
+
+		while((usAdded < TRACE_DUMP_FRAME_EVENTS) && (uxTraceGetEvents(&xEvent, uxDumpNext, 1) == 1))
+		{
+			Telemetry_add(&xWriter, TLM_TRACE, xEvent.ulTimestamp, TRACE_DUMP_VALUE(xEvent.ucEvent, xEvent.ucTask, xEvent.usParam));
+			uxDumpNext++;
+			usAdded++;
+		}
+
+		usTraceFrameLength = Telemetry_end(&xWriter);
+	}
+
+	if(vSerialPutString((signed char *)ucTraceFrame, usTraceFrameLength) == pdTRUE)
+	{
+		usTraceFrameLength = 0;
+
+		if(uxDumpNext >= uxDumpCount)
+		{
+			TraceDump_start();
+		}
+	}
+}
@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+"""Decode the COBS framed binary telemetry and logs sent over UART1.
+
+Reads the raw byte stream from a file, stdin or a serial port and prints one
+line per record.  Frames are split on the 0x00 delimiter, so decoding picks
+up again at the next frame after a corrupted or truncated one.  Log records
+only carry a format ID and raw argument words, they are formatted here with
+the strings from LOG_FORMATS in logger.h.  Kernel trace dumps are printed one
+event per line, job statistics one counter, histogram bucket, CPU time
+bucket or critical section call site per line.
+
+    telemetry_decode.py capture.bin
+    telemetry_decode.py --port COM3 --baud 115200
+    telemetry_decode.py --port COM3 --job-stats
+
+The frame layout is documented in Starter_Files_V1/header/telemetry.h.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+# Keep in step with telemetryType_t
+RECORD_TYPES = {
+    0: "BUTTON_1_EDGE",
+    1: "BUTTON_2_EDGE",
+    2: "PERIODIC_VALUE",
+    3: "LOG",
+    4: "TRACE_DUMP",
+    5: "TRACE",
+    6: "JOB_TASK",
+    7: "JOB_COUNTER",
+    8: "JOB_BUCKET",
+    9: "CPU_BUCKET",
+    10: "CPU_TIME",
+    11: "SITE_DROPPED",
+    12: "SITE",
+    13: "SITE_COUNT",
+    14: "SITE_MAX",
+    15: "SITE_BUCKET",
+}
+TLM_LOG = 3
+TLM_TRACE = 5
+TLM_JOB_TASK = 6
+TLM_JOB_COUNTER = 7
+TLM_JOB_BUCKET = 8
+TLM_CPU_BUCKET = 9
+TLM_CPU_TIME = 10
+TLM_SITE_DROPPED = 11
+TLM_SITE = 12
+TLM_SITE_COUNT = 13
+TLM_SITE_MAX = 14
+TLM_SITE_BUCKET = 15
+
+STREAMS = {0: "events", 1: "log", 2: "trace", 3: "stats"}
+
+# Keep in step with jobStatsCounter_t in job_stats.h and eJobHistogram in task.h
+JOB_COUNTERS = {0: "JOBS", 1: "CONTEXT_SWITCHES", 2: "PREEMPTIONS", 3: "DEADLINE_MISSES"}
+JOB_HISTOGRAMS = {0: "RESPONSE", 1: "LATENESS", 2: "START_JITTER", 3: "FINISH_JITTER"}
+
+# Keep in step with cpuBucket_t in job_stats.h
+CPU_BUCKET_TASK = 0
+CPU_BUCKET_SWITCHES = 4
+CPU_BUCKET_ISR = 6
+CPU_BUCKETS = {0: "TASK", 1: "IDLE", 2: "SCHEDULER", 3: "SWITCH", 4: "SWITCHES", 5: "TOTAL", 6: "ISR"}
+
+# ISR numbers given to traceISR_ENTER() in the demo, see FreeRTOSConfig.h
+CPU_ISRS = {0: "TICK", 1: "UART"}
+
+# Keep in step with the criticalFILE_ IDs in critical_profiler.h and the
+# CRITICAL_FILE_ IDs in FreeRTOSConfig.h
+CRITICAL_FILES = {
+    0: "?",
+    1: "tasks.c",
+    2: "queue.c",
+    3: "stream_buffer.c",
+    4: "timers.c",
+    5: "event_groups.c",
+    6: "mempool.c",
+    7: "let.c",
+    8: "heap",
+    16: "serial.c",
+    17: "latency.c",
+}
+CRITICAL_SITE_SUSPENDED = 0x80000000
+
+# Sent to start a job statistics dump, JOB_STATS_COMMAND in job_stats.h
+JOB_STATS_COMMAND = b"j"
+
+# Keep in step with the recorderEVENT_ values in trace_recorder.h
+TRACE_EVENTS = {
+    0: "SWITCH_IN",
+    1: "SWITCH_OUT",
+    2: "RELEASE",
+    3: "READY",
+    4: "BLOCK_DELAY",
+    5: "BLOCK_OBJECT",
+    6: "DEADLINE",
+    7: "DEADLINE_MISS",
+    8: "LET_OVERRUN",
+}
+SEQUENCE_MASK = 0x3F
+
+DEFAULT_FORMATS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                               "..", "Starter_Files_V1", "header", "logger.h")
+
+# Timer 1 counts PCLK / (T1PR + 1), see LATENCY_TIMER_PRESCALE
+TIMER_HZ = 60000000 / 1001
+
+# configCRITICAL_PROFILER_TIMESTAMP() is timer 0, which counts PCLK
+CRITICAL_HZ = 60000000
+
+
+class FrameError(Exception):
+    pass
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise FrameError("bad COBS block")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def read_varint(data, i):
+    value = 0
+    shift = 0
+    while True:
+        if i >= len(data) or shift > 28:
+            raise FrameError("truncated varint")
+        byte = data[i]
+        i += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte < 0x80:
+            return value, i
+
+
+def load_formats(path):
+    """Log format strings in LOG_FORMATS order, which is their ID."""
+    with open(path) as header:
+        text = header.read()
+    return re.findall(r'ENTRY\(\s*\w+\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', text)
+
+
+def format_log(formats, value, args):
+    fmt_id = value >> 2
+    if fmt_id >= len(formats):
+        return "LOG_%u %s" % (fmt_id, " ".join(str(a) for a in args))
+    specs = re.findall(r"%[-0-9]*([udx])", formats[fmt_id])
+    # Arguments are raw words, %d reads them back as signed
+    words = [a - (1 << 32) if (spec == "d" and a >= (1 << 31)) else a for a, spec in zip(args, specs)]
+    try:
+        return formats[fmt_id] % tuple(words)
+    except (TypeError, ValueError):
+        return "%s %r" % (formats[fmt_id], args)
+
+
+def unpack_trace(value):
+    """Split a TLM_TRACE value, see TRACE_DUMP_VALUE in trace_dump.h, into (event, task, param)."""
+    return value & 0x0F, (value >> 4) & 0xFF, (value >> 12) & 0xFFFF
+
+
+def format_trace(value):
+    event, task, param = unpack_trace(value)
+    return "task %u %s %u" % (task, TRACE_EVENTS.get(event, "EVENT_%u" % event), param)
+
+
+def format_job_counter(task, value):
+    """TLM_JOB_COUNTER value, see JOB_STATS_COUNTER_VALUE in job_stats.h."""
+    counter = value & 0x03
+    return "task %u %s %u" % (task, JOB_COUNTERS[counter], value >> 2)
+
+
+def format_job_bucket(task, value):
+    """TLM_JOB_BUCKET value, see JOB_STATS_BUCKET_VALUE in job_stats.h.
+
+    Bucket 0 holds values of 0, bucket n values from 2^(n-1) to 2^n - 1 timer
+    counts, the last bucket also everything above.
+    """
+    histogram = value & 0x03
+    bucket = (value >> 2) & 0x1F
+    low = 0 if bucket == 0 else 1 << (bucket - 1)
+    high = 0 if bucket == 0 else (1 << bucket) - 1
+    return "task %u %-13s %9.1f..%9.1f us %u" % (task, JOB_HISTOGRAMS[histogram],
+                                                 low * 1e6 / TIMER_HZ, high * 1e6 / TIMER_HZ, value >> 7)
+
+
+def format_cpu_time(task, bucket_value, value):
+    """TLM_CPU_TIME value, named by the TLM_CPU_BUCKET record before it, see
+    JOB_STATS_CPU_BUCKET_VALUE in job_stats.h."""
+    bucket = bucket_value & 0x07
+    name = CPU_BUCKETS.get(bucket, "BUCKET_%u" % bucket)
+    if bucket == CPU_BUCKET_TASK:
+        name = "task %u" % task
+    elif bucket == CPU_BUCKET_ISR:
+        isr = bucket_value >> 3
+        name = "ISR %s" % CPU_ISRS.get(isr, isr)
+    if bucket == CPU_BUCKET_SWITCHES:
+        return "%-10s %u" % (name, value)
+    return "%-10s %12.1f us" % (name, value * 1e6 / TIMER_HZ)
+
+
+def format_site(site):
+    """CriticalSite_t ulSite, see criticalSITE() in critical_profiler.h."""
+    kind = "suspended" if site & CRITICAL_SITE_SUSPENDED else "critical"
+    file_id = (site >> 16) & 0x7FFF
+    return "%s:%u %s" % (CRITICAL_FILES.get(file_id, "file_%u" % file_id), site & 0xFFFF, kind)
+
+
+def format_site_bucket(site, value):
+    """TLM_SITE_BUCKET value, see JOB_STATS_SITE_BUCKET_VALUE in job_stats.h."""
+    bucket = value & 0x1F
+    low = 0 if bucket == 0 else 1 << (bucket - 1)
+    high = 0 if bucket == 0 else (1 << bucket) - 1
+    return "%s %9.3f..%9.3f us %u" % (format_site(site), low * 1e6 / CRITICAL_HZ,
+                                      high * 1e6 / CRITICAL_HZ, value >> 5)
+
+
+def decode_frame(raw):
+    """Return (stream, sequence, [(type, stamp, value, args), ...]) for one decoded frame."""
+    if not raw:
+        raise FrameError("empty frame")
+    stream = raw[0] >> 6
+    sequence = raw[0] & SEQUENCE_MASK
+    records = []
+    stamp = 0
+    i = 1
+    while i < len(raw):
+        rtype = raw[i]
+        zigzag, i = read_varint(raw, i + 1)
+        value, i = read_varint(raw, i)
+        args = []
+        if rtype == TLM_LOG:
+            for _ in range(value & 0x03):
+                arg, i = read_varint(raw, i)
+                args.append(arg)
+        delta = (zigzag >> 1) ^ -(zigzag & 1)
+        stamp = (stamp + delta) & 0xFFFFFFFF
+        records.append((rtype, stamp, value, args))
+    return stream, sequence, records
+
+
+def frames(stream):
+    """Yield the COBS encoded body of each frame, without the delimiter."""
+    pending = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            return
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            yield bytes(pending[:end])
+            del pending[:end + 1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", help="raw capture file, stdin if omitted")
+    parser.add_argument("--port", help="read from a serial port instead (needs pyserial)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--formats", default=DEFAULT_FORMATS, help="logger.h holding LOG_FORMATS")
+    parser.add_argument("--job-stats", action="store_true",
+                        help="ask the target for its job statistics once the port is open")
+    args = parser.parse_args()
+
+    formats = load_formats(args.formats)
+
+    if args.port:
+        import serial
+        stream = serial.Serial(args.port, args.baud)
+        if args.job_stats:
+            stream.write(JOB_STATS_COMMAND)
+    elif args.capture:
+        stream = open(args.capture, "rb")
+    else:
+        stream = sys.stdin.buffer
+
+    expected = {}
+    lost = bad = 0
+    job_task = 0
+    cpu_bucket = 0
+    site = 0
+    try:
+        for body in frames(stream):
+            try:
+                stream_id, sequence, records = decode_frame(cobs_decode(body))
+            except FrameError as err:
+                # Also hit by the partial frame at the start of a capture
+                bad += 1
+                print("# dropped frame: %s" % err)
+                continue
+            name = STREAMS.get(stream_id, "stream_%u" % stream_id)
+            if stream_id in expected and sequence != expected[stream_id]:
+                gap = (sequence - expected[stream_id]) & SEQUENCE_MASK
+                lost += gap
+                print("# %d %s frame(s) lost" % (gap, name))
+            expected[stream_id] = (sequence + 1) & SEQUENCE_MASK
+            for rtype, stamp, value, log_args in records:
+                if rtype == TLM_LOG:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "LOG", format_log(formats, value, log_args)))
+                elif rtype == TLM_TRACE:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "TRACE", format_trace(value)))
+                elif rtype == TLM_JOB_TASK:
+                    job_task = value
+                elif rtype == TLM_JOB_COUNTER:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "JOB_COUNTER", format_job_counter(job_task, value)))
+                elif rtype == TLM_JOB_BUCKET:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "JOB_BUCKET", format_job_bucket(job_task, value)))
+                elif rtype == TLM_CPU_BUCKET:
+                    cpu_bucket = value
+                elif rtype == TLM_CPU_TIME:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "CPU_TIME", format_cpu_time(job_task, cpu_bucket, value)))
+                elif rtype == TLM_SITE:
+                    site = value
+                elif rtype == TLM_SITE_COUNT:
+                    print("%10.6f  %-16s %s %u" % (stamp / TIMER_HZ, "SITE_COUNT", format_site(site), value))
+                elif rtype == TLM_SITE_MAX:
+                    print("%10.6f  %-16s %s %.3f us" % (stamp / TIMER_HZ, "SITE_MAX", format_site(site), value * 1e6 / CRITICAL_HZ))
+                elif rtype == TLM_SITE_BUCKET:
+                    print("%10.6f  %-16s %s" % (stamp / TIMER_HZ, "SITE_BUCKET", format_site_bucket(site, value)))
+                else:
+                    print("%10.6f  %-16s %u" % (stamp / TIMER_HZ,
+                                                RECORD_TYPES.get(rtype, "TYPE_%u" % rtype), value))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    print("# %d frame(s) lost, %d undecodable" % (lost, bad))
+
+
+if __name__ == "__main__":
+    main()
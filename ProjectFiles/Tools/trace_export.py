@@ -0,0 +1,356 @@
+#!/usr/bin/env python3
+"""Convert kernel traces to Perfetto/Chrome JSON and SimSo comparable job tables.
+
+Traces come from the kernel trace recorder, either as dumped by the demo over
+UART1 (telemetry frames on the trace stream, see trace_dump.h) or as a raw
+array of TraceEvent_t records, 8 bytes each, little endian, which is what a
+host simulation build gets by writing out uxTraceGetEvents() to a file.
+
+    trace_export.py export capture.bin --json trace.json --jobs jobs.csv
+    trace_export.py export host_trace.bin --raw --timer-hz 1000000 --jobs jobs.csv
+    trace_export.py simso ../FWD.xml --jobs simso.csv
+    trace_export.py compare jobs.csv simso.csv --tolerance 0.1
+
+The JSON opens in ui.perfetto.dev or chrome://tracing: one track per task
+with a slice for every time it ran, release and deadline markers, and the
+jobs that missed their deadline flagged.  The job table has one row per job,
+in the fields SimSo reports, with times in ms from the start of the
+scheduler.  Jobs are numbered from the activation time and the period, so a
+trace that only covers a window still lines up with a full SimSo run.
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import telemetry_decode as tlm  # noqa: E402
+
+# Keep in step with the recorderEVENT_ values in trace_recorder.h
+SWITCH_IN, SWITCH_OUT, RELEASE, READY, BLOCK_DELAY, BLOCK_OBJECT, DEADLINE, DEADLINE_MISS, LET_OVERRUN = range(9)
+
+TLM_TRACE_DUMP = 4
+TRACE_STREAM = 2
+RAW_RECORD = struct.Struct("<IBBH")
+
+DEFAULT_TASKS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             "..", "Starter_Files_V1", "header", "main.h")
+
+JOB_FIELDS = ["task", "name", "job", "activation", "start", "end", "deadline", "response", "missed"]
+
+
+class Task(object):
+    def __init__(self, number, name, period=None, deadline=None):
+        self.number = number
+        self.name = name
+        self.period = period
+        self.deadline = deadline
+
+
+def load_tasks(path):
+    """Tasks of TASK_TABLE in main.h, numbered in creation order, then the idle task."""
+    with open(path) as header:
+        text = header.read()
+    defines = {}
+    for name, value in re.findall(r"#define\s+(\w+)\s+\(*(?:\(\w+\))?\s*(\d+)\s*\)*", text):
+        defines[name] = int(value)
+
+    def number(token):
+        token = token.strip()
+        return int(token) if token.isdigit() else defines.get(token)
+
+    table = text[text.index("#define TASK_TABLE"):]
+    tasks = {}
+    for entry in re.findall(r"ENTRY\(\s*\w+\s*,\s*\"([^\"]*)\"\s*,([^)]*)\)", table):
+        fields = entry[1].split(",")
+        tasks[len(tasks) + 1] = Task(len(tasks) + 1, entry[0], number(fields[0]), number(fields[1]))
+    tasks[len(tasks) + 1] = Task(len(tasks) + 1, "IDLE")
+    return tasks
+
+
+def read_uart(path):
+    """Trace dumps in a UART capture, each a list of (stamp, event, task, param), oldest first."""
+    dumps = []
+    with open(path, "rb") as stream:
+        for body in tlm.frames(stream):
+            try:
+                stream_id, _, records = tlm.decode_frame(tlm.cobs_decode(body))
+            except tlm.FrameError:
+                continue
+            if stream_id != TRACE_STREAM:
+                continue
+            for rtype, stamp, value, _ in records:
+                if rtype == TLM_TRACE_DUMP:
+                    dumps.append([])
+                elif rtype == tlm.TLM_TRACE and dumps:
+                    dumps[-1].append((stamp,) + tlm.unpack_trace(value))
+    return dumps
+
+
+def read_raw(path):
+    with open(path, "rb") as stream:
+        data = stream.read()
+    usable = len(data) - (len(data) % RAW_RECORD.size)
+    return [[RAW_RECORD.unpack_from(data, i) for i in range(0, usable, RAW_RECORD.size)]]
+
+
+def unwrap(value, reference, bits):
+    """The value congruent to value modulo 2^bits closest to reference."""
+    span = 1 << bits
+    return value + span * round((reference - value) / float(span))
+
+
+class Job(object):
+    def __init__(self, task, activation):
+        self.task = task
+        self.activation = activation                # ticks
+        self.deadline = activation + task.deadline  # ticks
+        self.number = activation // task.period + 1
+        self.start = None                           # us
+        self.end = None                             # us
+        self.missed = False
+
+
+def convert(events, tasks, timer_hz, tick_hz):
+    """Return the Chrome trace events and the jobs of one dump."""
+    us_per_count = 1e6 / timer_hz
+    us_per_tick = 1e6 / tick_hz
+
+    # Stamps are 32 bit counts that wrap, ticks are the low 16 bits of the tick count
+    stamps = []
+    last = None
+    for stamp, _, _, _ in events:
+        stamp = stamp if last is None else unwrap(stamp, last, 32)
+        stamps.append(stamp)
+        last = stamp
+
+    # The timestamp counter starts with the scheduler, so it gives the tick count
+    # to within a few ticks, close enough to unwrap the 16 bit parameters
+    def ticks(i, param):
+        return unwrap(param, stamps[i] * us_per_count / us_per_tick, 16)
+
+    # Each release happened at a known tick: line the tick time base up with the stamps
+    offsets = sorted(stamps[i] * us_per_count - ticks(i, param) * us_per_tick
+                     for i, (_, event, _, param) in enumerate(events) if event == RELEASE)
+    offset = offsets[len(offsets) // 2] if offsets else 0.0
+
+    def tick_us(tick):
+        return tick * us_per_tick + offset
+
+    trace = [{"ph": "M", "name": "process_name", "pid": 1, "args": {"name": "EDF kernel trace"}}]
+    for task in tasks.values():
+        trace.append({"ph": "M", "name": "thread_name", "pid": 1, "tid": task.number, "args": {"name": task.name}})
+        trace.append({"ph": "M", "name": "thread_sort_index", "pid": 1, "tid": task.number,
+                      "args": {"sort_index": task.number}})
+
+    def instant(tid, ts, name, **args):
+        trace.append({"ph": "i", "s": "t", "pid": 1, "tid": tid, "ts": ts, "name": name, "args": args})
+
+    jobs = []
+    current = {}
+    running = {}
+    for i, (_, event, number, param) in enumerate(events):
+        now = stamps[i] * us_per_count
+        task = tasks.get(number)
+        if task is None:
+            task = tasks[number] = Task(number, "task %u" % number)
+        job = current.get(number)
+        periodic = task.period is not None
+
+        if event == SWITCH_IN:
+            running[number] = now
+            if job is not None and job.start is None and job.end is None:
+                job.start = now
+        elif event == SWITCH_OUT:
+            if number in running:
+                begin = running.pop(number)
+                # The slice belongs to the job that was current when it began
+                name = task.name
+                if job is not None and (job.end is None or job.end > begin):
+                    name = "%s #%u" % (task.name, job.number)
+                trace.append({"ph": "X", "pid": 1, "tid": number, "ts": begin, "dur": now - begin, "name": name})
+        elif event == RELEASE:
+            instant(number, now, "release", tick=ticks(i, param))
+            if periodic:
+                job = current[number] = Job(task, ticks(i, param))
+                jobs.append(job)
+                instant(number, tick_us(job.deadline), "deadline", job=job.number)
+                if number in running:
+                    job.start = now
+        elif event == BLOCK_DELAY:
+            instant(number, now, "block", until=ticks(i, param))
+            if job is not None and job.end is None:
+                job.end = now
+        elif event == BLOCK_OBJECT:
+            instant(number, now, "block", object="0x%04x" % param)
+        elif event == DEADLINE:
+            deadline = ticks(i, param)
+            instant(number, now, "deadline set", deadline=deadline)
+            # A job that completes after the release of the next one does not
+            # block, the deadline of the next job is all that marks its end
+            if job is not None and periodic and deadline == job.deadline + task.period and job.end is None:
+                job.end = now
+                job = current[number] = Job(task, deadline - task.deadline)
+                job.start = now
+                jobs.append(job)
+                instant(number, tick_us(job.deadline), "deadline", job=job.number)
+        elif event == DEADLINE_MISS:
+            instant(number, now, "DEADLINE MISS", deadline=ticks(i, param))
+            if job is not None:
+                job.missed = True
+        elif event == LET_OVERRUN:
+            instant(number, now, "LET overrun")
+
+    # Flag the slices of the jobs that missed on the same track
+    for job in jobs:
+        if job.end is not None and job.end > tick_us(job.deadline):
+            job.missed = True
+        if job.missed:
+            instant(job.task.number, tick_us(job.deadline), "MISSED", job=job.number)
+
+    return trace, jobs, offset
+
+
+def job_rows(jobs, offset, tick_hz):
+    """Jobs in the SimSo fields, times in ms from the start of the scheduler."""
+    def ms(us):
+        return "" if us is None else "%.3f" % ((us - offset) / 1000.0)
+
+    ms_per_tick = 1000.0 / tick_hz
+    rows = []
+    for job in jobs:
+        activation = job.activation * ms_per_tick
+        rows.append({
+            "task": job.task.number,
+            "name": job.task.name,
+            "job": job.number,
+            "activation": "%.3f" % activation,
+            "start": ms(job.start),
+            "end": ms(job.end),
+            "deadline": "%.3f" % (job.deadline * ms_per_tick),
+            "response": "" if job.end is None else "%.3f" % ((job.end - offset) / 1000.0 - activation),
+            "missed": int(job.missed),
+        })
+    return rows
+
+
+def write_rows(path, rows):
+    with open(path, "w", newline="") as out:
+        writer = csv.DictWriter(out, fieldnames=JOB_FIELDS)
+        writer.writeheader()
+        for row in sorted(rows, key=lambda r: (int(r["task"]), int(r["job"]))):
+            writer.writerow(row)
+
+
+def command_export(args):
+    tasks = load_tasks(args.tasks)
+    dumps = read_raw(args.trace) if args.raw else read_uart(args.trace)
+    dumps = [dump for dump in dumps if dump]
+    if not dumps:
+        sys.exit("no trace events in %s" % args.trace)
+    events = dumps[args.dump]
+    trace, jobs, offset = convert(events, tasks, args.timer_hz, args.tick_hz)
+    if args.json:
+        with open(args.json, "w") as out:
+            json.dump({"traceEvents": trace, "displayTimeUnit": "ms"}, out)
+    if args.jobs:
+        write_rows(args.jobs, job_rows(jobs, offset, args.tick_hz))
+    print("%d dump(s), %d events, %d jobs, %d missed" % (len(dumps), len(events), len(jobs),
+                                                         sum(1 for job in jobs if job.missed)))
+
+
+def command_simso(args):
+    """Run FWD.xml through SimSo and write its jobs in the same table."""
+    from simso.configuration import Configuration
+    from simso.core import Model
+
+    configuration = Configuration(args.config)
+    if args.duration_ms:
+        configuration.duration = int(args.duration_ms * configuration.cycles_per_ms)
+    configuration.check_all()
+    model = Model(configuration)
+    model.run_model()
+
+    cycles_per_ms = float(configuration.cycles_per_ms)
+    rows = []
+    # Activation and deadline are in ms, start and end in cycles
+    for task in model.task_list:
+        for job in task.jobs:
+            end = None if job.end_date is None else job.end_date / cycles_per_ms
+            rows.append({
+                "task": task.identifier,
+                "name": task.name,
+                "job": int(round(job.activation_date / task.period)) + 1,
+                "activation": "%.3f" % job.activation_date,
+                "start": "" if job.start_date is None else "%.3f" % (job.start_date / cycles_per_ms),
+                "end": "" if end is None else "%.3f" % end,
+                "deadline": "%.3f" % job.absolute_deadline,
+                "response": "" if end is None else "%.3f" % (end - job.activation_date),
+                "missed": int(bool(job.exceeded_deadline)),
+            })
+    write_rows(args.jobs, rows)
+    print("%d jobs" % len(rows))
+
+
+def command_compare(args):
+    """Compare two job tables on the jobs both hold, exit status 1 on any difference."""
+    def load(path):
+        with open(path, newline="") as table:
+            return {(int(row["task"]), int(row["job"])): row for row in csv.DictReader(table)}
+
+    left = load(args.left)
+    right = load(args.right)
+    common = sorted(set(left) & set(right))
+    differences = 0
+    for key in common:
+        for field in ("activation", "deadline", "start", "end", "response", "missed"):
+            a = left[key][field]
+            b = right[key][field]
+            if a == "" or b == "":
+                continue
+            if abs(float(a) - float(b)) > (0 if field == "missed" else args.tolerance):
+                differences += 1
+                print("task %u job %u %s: %s vs %s" % (key[0], key[1], field, a, b))
+    print("%d jobs compared, %d only in %s, %d only in %s, %d difference(s)"
+          % (len(common), len(set(left) - set(right)), args.left, len(set(right) - set(left)), args.right, differences))
+    sys.exit(1 if differences else 0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    commands = parser.add_subparsers(dest="command")
+    commands.required = True
+
+    export = commands.add_parser("export", help="convert a trace")
+    export.add_argument("trace", help="UART capture, or raw TraceEvent_t records with --raw")
+    export.add_argument("--raw", action="store_true", help="trace is an array of TraceEvent_t, from a host build")
+    export.add_argument("--dump", type=int, default=-1, help="dump of the capture to convert, the last by default")
+    export.add_argument("--json", help="Perfetto/Chrome trace output")
+    export.add_argument("--jobs", help="job table output")
+    export.add_argument("--tasks", default=DEFAULT_TASKS, help="main.h holding TASK_TABLE")
+    export.add_argument("--timer-hz", type=float, default=tlm.TIMER_HZ, help="rate of the trace timestamps")
+    export.add_argument("--tick-hz", type=float, default=1000.0, help="configTICK_RATE_HZ")
+    export.set_defaults(run=command_export)
+
+    simso = commands.add_parser("simso", help="run a SimSo configuration, needs the simso package")
+    simso.add_argument("config", help="SimSo XML, such as FWD.xml")
+    simso.add_argument("--jobs", required=True, help="job table output")
+    simso.add_argument("--duration-ms", type=float, help="override the simulated duration")
+    simso.set_defaults(run=command_simso)
+
+    compare = commands.add_parser("compare", help="diff two job tables")
+    compare.add_argument("left")
+    compare.add_argument("right")
+    compare.add_argument("--tolerance", type=float, default=0.1, help="ms allowed between times")
+    compare.set_defaults(run=command_compare)
+
+    args = parser.parse_args()
+    args.run(args)
+
+
+if __name__ == "__main__":
+    main()